@@ -45,6 +45,10 @@ var package = Package(
             name: "changelog-authors",
             dependencies: ["ArgumentParser"],
             path: "Tools/changelog-authors"),
+        .target(
+            name: "parse-benchmark",
+            dependencies: ["ArgumentParser"],
+            path: "Tools/parse-benchmark"),
 
         .testTarget(
             name: "ArgumentParserEndToEndTests",
@@ -17,14 +17,56 @@ struct BashCompletionsGenerator {
     return """
     #!/bin/bash
 
-    \(generateCompletionFunction([type]))
+    \(generateCompletionFunction([type], lazily: type.configuration.lazilyLoadsSubcommandCompletions))
+    \(generateCompletionServerFunctions(type))
 
     complete -F \(initialFunctionName) \(type._commandName)
     """
   }
 
+  /// Generates the functions that start a completion server for the given
+  /// command and send it custom completion requests.
+  ///
+  /// Bash doesn't share a coprocess's file descriptors with subshells, so
+  /// the server's pipes are duplicated onto ordinary descriptors that the
+  /// request function can use from inside a command substitution.
+  fileprivate static func generateCompletionServerFunctions(_ type: ParsableCommand.Type) -> String {
+    let prefix = type.completionServerPrefix
+    return """
+    \(prefix)_start_completion_server() {
+        [[ -n $SWIFT_ARGUMENT_PARSER_COMPLETION_SERVER ]] || return
+        [[ -n $\(prefix)_server_out ]] && kill -0 "$\(prefix)_server_PID" 2>/dev/null && return
+        [[ -n $\(prefix)_server_out ]] && exec {\(prefix)_server_in}<&- {\(prefix)_server_out}>&-
+        { coproc \(prefix)_server { "${COMP_WORDS[0]}" ---completion-server 2>/dev/null; }; } 2>/dev/null
+        exec {\(prefix)_server_in}<&"${\(prefix)_server[0]}" {\(prefix)_server_out}>&"${\(prefix)_server[1]}"
+    }
+    \(prefix)_completion_request() {
+        if [[ -n $\(prefix)_server_out ]] && kill -0 "$\(prefix)_server_PID" 2>/dev/null; then
+            local count line
+            printf '%s\\0' "$(($# - 1))" "${@:2}" >&"$\(prefix)_server_out"
+            IFS= read -r count <&"$\(prefix)_server_in" || return
+            while (( count-- > 0 )) && IFS= read -r line <&"$\(prefix)_server_in"; do
+                printf '%s\\n' "$line"
+            done
+            return
+        fi
+        "$@"
+    }
+    """
+  }
+
+  /// Generates the Bash completion functions for the last command in the
+  /// given list, for a script that loads subcommand completions lazily.
+  static func generateLazyCompletionFunction(_ commands: [ParsableCommand.Type]) -> String {
+    generateCompletionFunction(commands, lazily: true)
+  }
+
   /// Generates a Bash completion function for the last command in the given list.
-  fileprivate static func generateCompletionFunction(_ commands: [ParsableCommand.Type]) -> String {
+  ///
+  /// If `lazily` is `true`, each subcommand gets a function that loads its
+  /// completion functions from the command when it's first called, instead
+  /// of the completion functions themselves.
+  fileprivate static func generateCompletionFunction(_ commands: [ParsableCommand.Type], lazily: Bool = false) -> String {
     let type = commands.last!
     let functionName = commands.completionFunctionName()
     
@@ -60,6 +102,7 @@ struct BashCompletionsGenerator {
         cur="${COMP_WORDS[COMP_CWORD]}"
         prev="${COMP_WORDS[COMP_CWORD-1]}"
         COMPREPLY=()
+        \(type.completionServerPrefix)_start_completion_server
 
         """.indentingEachLine(by: 4)
     }
@@ -117,10 +160,30 @@ struct BashCompletionsGenerator {
 
     return result +
       subcommands
-        .map { generateCompletionFunction(commands + [$0]) }
+        .map { subcommand in
+          lazily && subcommand != HelpCommand.self
+            ? generateLoadingFunction(commands + [subcommand])
+            : generateCompletionFunction(commands + [subcommand], lazily: lazily)
+        }
         .joined()
   }
 
+  /// Generates a function that replaces itself with the completion functions
+  /// for the last command in the given list, as printed by the command's
+  /// `---completion-function` request, and then calls them.
+  fileprivate static func generateLoadingFunction(_ commands: [ParsableCommand.Type]) -> String {
+    let functionName = commands.completionFunctionName()
+    let subcommandNames = commands.dropFirst().map { $0._commandName }.joined(separator: " ")
+    return """
+    \(functionName)() {
+        local script
+        script="$("${COMP_WORDS[0]}" ---completion-function bash \(subcommandNames) 2>/dev/null)" && [[ -n $script ]] || return
+        eval "$script" && \(functionName) "$@"
+    }
+
+    """
+  }
+
   /// Returns the option and flag names that can be top-level completions.
   fileprivate static func generateArgumentWords(_ commands: [ParsableCommand.Type]) -> [String] {
     commands.argumentsForHelp().flatMap { $0.bashCompletionWords() }
@@ -149,7 +212,7 @@ struct BashCompletionsGenerator {
                 ?? arg.help.keys.first?.rawValue ?? "---"
           
           return """
-            $("${COMP_WORDS[0]}" ---completion \(subcommandNames) -- \(argumentName) "${COMP_WORDS[@]}")
+            $(\(commands[0].completionServerPrefix)_completion_request "${COMP_WORDS[0]}" ---completion \(subcommandNames) -- \(argumentName) "${COMP_WORDS[@]}")
             """
         }
       }
@@ -206,7 +269,7 @@ extension ArgumentDefinition {
         
     case .custom:
       // Generate a call back into the command to retrieve a completions list
-      return #"COMPREPLY=( $(compgen -W "$("${COMP_WORDS[0]}" \#(customCompletionCall(commands)) "${COMP_WORDS[@]}")" -- "$cur") )"#
+      return #"COMPREPLY=( $(compgen -W "$(\#(commands[0].completionServerPrefix)_completion_request "${COMP_WORDS[0]}" \#(customCompletionCall(commands)) "${COMP_WORDS[@]}")" -- "$cur") )"#
     }
   }
 }
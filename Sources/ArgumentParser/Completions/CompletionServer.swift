@@ -0,0 +1,94 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#elseif canImport(CRT)
+import CRT
+#endif
+
+/// A long-running process that answers custom completion requests.
+///
+/// The generated Bash and Zsh completion scripts start a server as a
+/// coprocess when `SWIFT_ARGUMENT_PARSER_COMPLETION_SERVER` is set, and send
+/// it each `---completion` request instead of running the command again.
+/// Argument sets, and anything the completion closures cache, stay warm
+/// between requests for the lifetime of the shell.
+///
+/// A request is a series of NUL-terminated records: the number of
+/// arguments, followed by each argument, so that an argument can contain a
+/// newline. A response is framed by lines: the number of completions on one
+/// line, followed by each completion on its own line. Requests that can't be
+/// answered get an empty response.
+struct CompletionServer {
+  var rootCommand: ParsableCommand.Type
+
+  /// Answers requests from standard input until it's closed.
+  func serveStandardInput() {
+    serve(readRecord: CompletionServer.readStandardInputRecord) { response in
+      print(response, terminator: "")
+      fflush(stdout)
+    }
+  }
+
+  /// Answers requests read with `readRecord`, passing each framed response
+  /// to `write`, until `readRecord` returns `nil`.
+  func serve(readRecord: () -> String?, write: (String) -> Void) {
+    while let header = readRecord() {
+      guard let count = Int(header), count >= 0 else {
+        write(framed([]))
+        continue
+      }
+
+      var arguments: [String] = []
+      for _ in 0..<count {
+        guard let argument = readRecord() else { return }
+        arguments.append(argument)
+      }
+      write(framed(completions(for: arguments)))
+    }
+  }
+
+  /// Returns the completions for a single request, or an empty array if the
+  /// request isn't a valid `---completion` request.
+  func completions(for arguments: [String]) -> [String] {
+    guard let completions = try? CommandParser.customCompletions(for: arguments, rootCommand: rootCommand)
+      else { return [] }
+
+    // A completion can't span lines without breaking the framing, so lines
+    // are sent as separate completions, like `---completion` prints them.
+    return completions.flatMap {
+      $0.split(separator: "\n", omittingEmptySubsequences: false).map(String.init)
+    }
+  }
+
+  private func framed(_ completions: [String]) -> String {
+    ([String(completions.count)] + completions).map { $0 + "\n" }.joined()
+  }
+
+  /// Reads a NUL-terminated record from standard input, or returns `nil` at
+  /// the end of the input. A final record without a terminator is kept.
+  private static func readStandardInputRecord() -> String? {
+    var bytes: [UInt8] = []
+    while true {
+      let c = getchar()
+      if c == EOF {
+        return bytes.isEmpty ? nil : String(decoding: bytes, as: UTF8.self)
+      }
+      if c == 0 {
+        return String(decoding: bytes, as: UTF8.self)
+      }
+      bytes.append(UInt8(truncatingIfNeeded: c))
+    }
+  }
+}
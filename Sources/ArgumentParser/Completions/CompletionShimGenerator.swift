@@ -0,0 +1,112 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// Generates small shell snippets that load a command's completion script
+/// from a cache, regenerating the script only when the command changes.
+///
+/// Generating a completion script walks the entire command tree, which is
+/// too slow to do every time a shell starts. The shim instead reads the
+/// script from `$XDG_CACHE_HOME` (or `~/.cache`), in a directory named for the
+/// command's version. The cached script is regenerated when it's missing or
+/// when the command's executable is newer than the cached file, so rebuilding
+/// a tool without changing its version still refreshes its completions.
+struct CompletionShimGenerator {
+  /// Generates a shim for the given command and shell.
+  static func generateCompletionShim(_ type: ParsableCommand.Type, shell: CompletionShell) -> String {
+    let commandName = type._commandName
+    let directory = "swift-argument-parser/\(commandName)/\(cacheKey(for: type))"
+    let functionName = "_\(commandName.replacingOccurrences(of: "-", with: "_"))_load_completions"
+
+    switch shell {
+    case .bash:
+      return """
+        \(functionName)() {
+            local binary cache
+            binary="$(command -v \(commandName))" || return
+            cache="${XDG_CACHE_HOME:-$HOME/.cache}/\(directory)/\(commandName).bash"
+            if [ ! -s "$cache" ] || [ "$binary" -nt "$cache" ]; then
+                mkdir -p "${cache%/*}" &&
+                    "$binary" --generate-completion-script bash > "$cache.$$" &&
+                    mv -f "$cache.$$" "$cache" ||
+                    { rm -f "$cache.$$"; return 1; }
+            fi
+            . "$cache"
+        }
+        \(functionName)
+        unset -f \(functionName)
+
+        """
+
+    case .zsh:
+      let completionFunctionName = [type].completionFunctionName()
+      return """
+        \(functionName)() {
+            local binary cache
+            binary="$(command -v \(commandName))" || return
+            cache="${XDG_CACHE_HOME:-$HOME/.cache}/\(directory)/\(completionFunctionName)"
+            if [[ ! -s $cache || $binary -nt $cache ]]; then
+                mkdir -p "${cache:h}" &&
+                    "$binary" --generate-completion-script zsh >| "$cache.$$" &&
+                    mv -f "$cache.$$" "$cache" ||
+                    { rm -f "$cache.$$"; return 1; }
+            fi
+            fpath=("${cache:h}" $fpath)
+            autoload -Uz \(completionFunctionName)
+            (( $+functions[compdef] )) && compdef \(completionFunctionName) \(commandName)
+        }
+        \(functionName)
+        unfunction \(functionName)
+
+        """
+
+    case .fish:
+      // fish's builtin `test` doesn't compare modification times, so this
+      // uses the external `test` command for `-nt`.
+      return """
+        function \(functionName)
+            set -l binary (command -v \(commandName)); or return
+            set -l cache_home $XDG_CACHE_HOME
+            test -n "$cache_home"; or set cache_home $HOME/.cache
+            set -l cache $cache_home/\(directory)/\(commandName).fish
+            if not test -s $cache; or command test $binary -nt $cache
+                mkdir -p (dirname $cache)
+                and $binary --generate-completion-script fish > $cache.$fish_pid
+                and mv -f $cache.$fish_pid $cache
+                or begin
+                    rm -f $cache.$fish_pid
+                    return 1
+                end
+            end
+            source $cache
+        end
+        \(functionName)
+        functions -e \(functionName)
+
+        """
+
+    default:
+      fatalError("Invalid CompletionShell: \(shell)")
+    }
+  }
+
+  /// Returns the name of the cache directory for the given command's
+  /// version, using only characters that are safe in an unquoted path.
+  static func cacheKey(for type: ParsableCommand.Type) -> String {
+    let version = type.configuration.version
+    guard !version.isEmpty else { return "unversioned" }
+
+    return String(version.map { c -> Character in
+      c.isASCII && (c.isLetter || c.isNumber || c == "." || c == "-" || c == "_")
+        ? c
+        : "_"
+    })
+  }
+}
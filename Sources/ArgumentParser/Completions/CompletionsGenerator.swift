@@ -95,6 +95,12 @@ struct CompletionsGenerator {
       fatalError("Invalid CompletionShell: \(shell)")
     }
   }
+  
+  /// Generates a shim that loads this generator's completion script from a
+  /// cache, regenerating it only when the command changes.
+  func generateCompletionShim() -> String {
+    CompletionShimGenerator.generateCompletionShim(command, shell: shell)
+  }
 }
 
 extension ArgumentDefinition {
@@ -116,6 +122,12 @@ extension ParsableCommand {
       return _commandName.split(separator: " ").map(String.init)
     }
   }
+  
+  /// The prefix for the shell functions and variables that a completion
+  /// script uses to talk to this command's completion server.
+  static var completionServerPrefix: String {
+    "__" + String(_commandName.map { $0.isLetter || $0.isNumber ? $0 : "_" })
+  }
 }
 
 extension Sequence where Element == ParsableCommand.Type {
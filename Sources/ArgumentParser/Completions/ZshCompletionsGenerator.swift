@@ -20,17 +20,63 @@ struct ZshCompletionsGenerator {
     _\(type._commandName.zshEscapingCommandName())_commandname=$words[1]
     typeset -A opt_args
 
-    \(generateCompletionFunction([type]))
+    \(generateCompletionFunction([type], lazily: type.configuration.lazilyLoadsSubcommandCompletions))
     _custom_completion() {
         local completions=("${(@f)$($*)}")
         _describe '' completions
     }
+    \(generateCompletionServerFunctions(type))
 
     \(initialFunctionName)
     """
   }
+
+  /// Generates the functions that start a completion server for the given
+  /// command and send it custom completion requests.
+  ///
+  /// The coprocess's pipes are moved onto descriptors of their own, so that
+  /// other commands can keep using `coproc`.
+  static func generateCompletionServerFunctions(_ type: ParsableCommand.Type) -> String {
+    let prefix = type.completionServerPrefix
+    let commandNameVariable = "$_\(type._commandName.zshEscapingCommandName())_commandname"
+    return """
+    \(prefix)_start_completion_server() {
+        [[ -n $SWIFT_ARGUMENT_PARSER_COMPLETION_SERVER ]] || return
+        [[ -n $\(prefix)_server_out ]] && kill -0 $\(prefix)_server_pid 2>/dev/null && return
+        [[ -n $\(prefix)_server_out ]] && exec {\(prefix)_server_in}<&- {\(prefix)_server_out}>&-
+        setopt local_options no_monitor no_notify
+        coproc \(commandNameVariable) ---completion-server 2>/dev/null
+        \(prefix)_server_pid=$!
+        exec {\(prefix)_server_in}<&p {\(prefix)_server_out}>&p
+    }
+    \(prefix)_completion_request() {
+        if [[ -n $\(prefix)_server_out ]] && kill -0 $\(prefix)_server_pid 2>/dev/null; then
+            local count line
+            print -rN -- $(($# - 1)) "${@:2}" >&$\(prefix)_server_out
+            IFS= read -r count <&$\(prefix)_server_in || return
+            while (( count-- > 0 )) && IFS= read -r line <&$\(prefix)_server_in; do
+                print -r -- "$line"
+            done
+            return
+        fi
+        "$@"
+    }
+    """
+  }
+  
+  /// Generates the Zsh completion functions for the last command in the
+  /// given list, for a script that loads subcommand completions lazily.
+  static func generateLazyCompletionFunction(_ commands: [ParsableCommand.Type]) -> String {
+    generateCompletionFunction(commands, lazily: true)
+  }
   
-  static func generateCompletionFunction(_ commands: [ParsableCommand.Type]) -> String {
+  /// Generates a Zsh completion function for the last command in the given
+  /// list.
+  ///
+  /// If `lazily` is `true`, each subcommand gets a function that loads its
+  /// completion functions from the command when it's first called, instead
+  /// of the completion functions themselves.
+  static func generateCompletionFunction(_ commands: [ParsableCommand.Type], lazily: Bool = false) -> String {
     let type = commands.last!
     let functionName = commands.completionFunctionName()
     let isRootCommand = commands.count == 1
@@ -83,10 +129,15 @@ struct ZshCompletionsGenerator {
         .indentingEachLine(by: 4)
     }
     
+    // The root command's function starts the completion server, if enabled.
+    let serverSetup = isRootCommand
+      ? "\n    \(type.completionServerPrefix)_start_completion_server"
+      : ""
+    
     let functionText = """
       \(functionName)() {
           integer ret=1
-          local -a args
+          local -a args\(serverSetup)
           args+=(
       \(args.joined(separator: "\n").indentingEachLine(by: 8))
           )
@@ -100,10 +151,32 @@ struct ZshCompletionsGenerator {
     
     return functionText +
       subcommands
-        .map { generateCompletionFunction(commands + [$0]) }
+        .map { subcommand in
+          lazily && subcommand != HelpCommand.self
+            ? generateLoadingFunction(commands + [subcommand])
+            : generateCompletionFunction(commands + [subcommand], lazily: lazily)
+        }
         .joined()
   }
 
+  /// Generates a function that replaces itself with the completion functions
+  /// for the last command in the given list, as printed by the command's
+  /// `---completion-function` request, and then calls them.
+  static func generateLoadingFunction(_ commands: [ParsableCommand.Type]) -> String {
+    let functionName = commands.completionFunctionName()
+    let commandNameVariable = "$_\(commands[0]._commandName.zshEscapingCommandName())_commandname"
+    let subcommandNames = commands.dropFirst().map { $0._commandName }.joined(separator: " ")
+    return """
+      \(functionName)() {
+          local script
+          script="$(\(commandNameVariable) ---completion-function zsh \(subcommandNames) 2>/dev/null)" && [[ -n $script ]] || return 1
+          eval "$script" && \(functionName) "$@"
+      }
+
+
+      """
+  }
+
   static func generateCompletionArguments(_ commands: [ParsableCommand.Type]) -> [String] {
     commands.argumentsForHelp().compactMap { $0.zshCompletionString(commands) }
   }
@@ -188,7 +261,7 @@ extension ArgumentDefinition {
     case .custom:
       // Generate a call back into the command to retrieve a completions list
       let commandName = commands.first!._commandName
-      return "{_custom_completion $_\(commandName)_commandname \(customCompletionCall(commands)) $words}"
+      return "{_custom_completion \(commands[0].completionServerPrefix)_completion_request $_\(commandName)_commandname \(customCompletionCall(commands)) $words}"
     }
   }
 }
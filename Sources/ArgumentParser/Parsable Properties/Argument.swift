@@ -303,6 +303,7 @@ extension Argument {
   private init<Element>(
     initial: Value?,
     parsingStrategy: ArgumentArrayParsingStrategy,
+    conversionStrategy: ArrayConversionStrategy,
     help: ArgumentHelp?,
     completion: CompletionKind?
   )
@@ -331,6 +332,9 @@ extension Argument {
         update: .appendToArray(forType: Element.self, key: key),
         initial: setInitialValue)
       arg.help.defaultValue = helpDefaultValue
+      if conversionStrategy.isConcurrent {
+        arg.convertValuesConcurrently(forKey: key) { Element(argument: $0) }
+      }
       return ArgumentSet(arg)
     })
   }
@@ -341,10 +345,13 @@ extension Argument {
   ///   - initial: A default value to use for this property.
   ///   - parsingStrategy: The behavior to use when parsing multiple values
   ///     from the command-line arguments.
+  ///   - conversionStrategy: The behavior to use when converting the
+  ///     values to the element type.
   ///   - help: Information about how to use this argument.
   public init<Element>(
     wrappedValue: Value,
     parsing parsingStrategy: ArgumentArrayParsingStrategy = .remaining,
+    conversion conversionStrategy: ArrayConversionStrategy = .serial,
     help: ArgumentHelp? = nil,
     completion: CompletionKind? = nil
   )
@@ -353,6 +360,7 @@ extension Argument {
     self.init(
       initial: wrappedValue,
       parsingStrategy: parsingStrategy,
+      conversionStrategy: conversionStrategy,
       help: help,
       completion: completion
     )
@@ -368,9 +376,11 @@ extension Argument {
   ///
   /// - Parameters:
   ///   - parsingStrategy: The behavior to use when parsing multiple values from the command-line arguments.
+  ///   - conversionStrategy: The behavior to use when converting the values to the element type.
   ///   - help: Information about how to use this argument.
   public init<Element>(
     parsing parsingStrategy: ArgumentArrayParsingStrategy = .remaining,
+    conversion conversionStrategy: ArrayConversionStrategy = .serial,
     help: ArgumentHelp? = nil,
     completion: CompletionKind? = nil
   )
@@ -379,6 +389,7 @@ extension Argument {
     self.init(
       initial: nil,
       parsingStrategy: parsingStrategy,
+      conversionStrategy: conversionStrategy,
       help: help,
       completion: completion
     )
@@ -390,6 +401,7 @@ extension Argument {
   private init<Element>(
     initial: Value?,
     parsingStrategy: ArgumentArrayParsingStrategy,
+    conversionStrategy: ArrayConversionStrategy,
     help: ArgumentHelp?,
     completion: CompletionKind?,
     transform: @escaping (String) throws -> Element
@@ -429,6 +441,9 @@ extension Argument {
         }),
         initial: setInitialValue)
       arg.help.defaultValue = helpDefaultValue
+      if conversionStrategy.isConcurrent {
+        arg.convertValuesConcurrently(forKey: key, transform)
+      }
       return ArgumentSet(arg)
     })
   }
@@ -440,12 +455,15 @@ extension Argument {
   ///   - initial: A default value to use for this property.
   ///   - parsingStrategy: The behavior to use when parsing multiple values
   ///     from the command-line arguments.
+  ///   - conversionStrategy: The behavior to use when converting the
+  ///     values to the element type.
   ///   - help: Information about how to use this argument.
   ///   - transform: A closure that converts a string into this property's
   ///     element type or throws an error.
   public init<Element>(
     wrappedValue: Value,
     parsing parsingStrategy: ArgumentArrayParsingStrategy = .remaining,
+    conversion conversionStrategy: ArrayConversionStrategy = .serial,
     help: ArgumentHelp? = nil,
     completion: CompletionKind? = nil,
     transform: @escaping (String) throws -> Element
@@ -455,6 +473,7 @@ extension Argument {
     self.init(
       initial: wrappedValue,
       parsingStrategy: parsingStrategy,
+      conversionStrategy: conversionStrategy,
       help: help,
       completion: completion,
       transform: transform
@@ -471,10 +490,12 @@ extension Argument {
   ///
   /// - Parameters:
   ///   - parsingStrategy: The behavior to use when parsing multiple values from the command-line arguments.
+  ///   - conversionStrategy: The behavior to use when converting the values to the element type.
   ///   - help: Information about how to use this argument.
   ///   - transform: A closure that converts a string into this property's element type or throws an error.
   public init<Element>(
     parsing parsingStrategy: ArgumentArrayParsingStrategy = .remaining,
+    conversion conversionStrategy: ArrayConversionStrategy = .serial,
     help: ArgumentHelp? = nil,
     completion: CompletionKind? = nil,
     transform: @escaping (String) throws -> Element
@@ -484,6 +505,7 @@ extension Argument {
     self.init(
       initial: nil,
       parsingStrategy: parsingStrategy,
+      conversionStrategy: conversionStrategy,
       help: help,
       completion: completion,
       transform: transform
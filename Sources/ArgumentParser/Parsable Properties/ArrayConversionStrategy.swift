@@ -0,0 +1,40 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// The strategy to use when converting the values of an array option or
+/// argument from strings to their element type.
+///
+/// Use the `.concurrent` strategy when converting each element is expensive,
+/// such as when a transform resolves a path or reads a file, and a command
+/// can receive many values:
+///
+///     @Argument(conversion: .concurrent, transform: Manifest.init(path:))
+///     var manifests: [Manifest]
+public struct ArrayConversionStrategy: Hashable {
+  internal var isConcurrent: Bool
+
+  /// Convert each value as soon as it's parsed.
+  ///
+  /// This is the default strategy.
+  public static var serial: ArrayConversionStrategy {
+    self.init(isConcurrent: false)
+  }
+
+  /// Convert all of the values at once, in parallel, after the command's
+  /// input has been parsed.
+  ///
+  /// The conversion must be safe to call from more than one thread at a
+  /// time. The elements keep the order of the input. If more than one value
+  /// fails to convert, the error describes the first of them in the input.
+  public static var concurrent: ArrayConversionStrategy {
+    self.init(isConcurrent: true)
+  }
+}
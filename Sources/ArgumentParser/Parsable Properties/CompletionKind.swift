@@ -9,6 +9,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+@_implementationOnly import Foundation
+
 /// The type of completion to use for an argument or option.
 public struct CompletionKind {
   internal enum Kind {
@@ -27,8 +29,16 @@ public struct CompletionKind {
     /// Call the given shell command to generate completions.
     case shellCommand(String)
 
-    /// Generate completions using the given closure.
-    case custom(([String]) -> [String])
+    /// Generate completions using the given closure, which also receives
+    /// the argument that completions are requested for.
+    case custom((_ arguments: [String], _ site: CompletionSite) -> [String])
+  }
+  
+  /// Identifies the argument of a command that completions are requested
+  /// for.
+  internal struct CompletionSite: Hashable {
+    var command: ObjectIdentifier
+    var argument: InputKey
   }
   
   internal var kind: Kind
@@ -60,6 +70,97 @@ public struct CompletionKind {
   
   /// Generate completions using the given closure.
   public static func custom(_ completion: @escaping ([String]) -> [String]) -> CompletionKind {
-    CompletionKind(kind: .custom(completion))
+    CompletionKind(kind: .custom { arguments, _ in completion(arguments) })
+  }
+  
+  /// Generate completions using the given closure, waiting no longer than
+  /// `timeout` seconds for it to finish.
+  ///
+  /// Use this completion kind when looking up completions can be slow, such
+  /// as when fetching the names of remote resources. The closure runs on a
+  /// background thread and adds completions to `results` as it finds them.
+  /// When `timeout` elapses, the shell receives the completions added so
+  /// far, and anything added later is discarded.
+  ///
+  /// The closure keeps running after its timeout, so calls for the same
+  /// argument run one at a time, in the order they were requested. A
+  /// request whose timeout passes while an earlier call is still running,
+  /// which can happen in a long-running completion server, gets no
+  /// completions, and the closure isn't called for it. Because the closure
+  /// runs on a background thread, any state it shares with the rest of
+  /// your program must be safe to access from multiple threads; calls for
+  /// different arguments can run at the same time.
+  ///
+  ///     @Option(completion: .custom(timeout: 0.5) { _, results in
+  ///         for page in Server.pagesOfBucketNames() {
+  ///             results.append(contentsOf: page)
+  ///         }
+  ///     })
+  ///     var bucket: String
+  public static func custom(
+    timeout: Double,
+    _ completion: @escaping (_ arguments: [String], _ results: CompletionResults) -> Void
+  ) -> CompletionKind {
+    CompletionKind(kind: .custom { arguments, site in
+      let queue = timedCompletionQueues.value(forKey: site) {
+        DispatchQueue(label: "ArgumentParser.timedCompletion")
+      }
+      let results = CompletionResults()
+      let finished = DispatchSemaphore(value: 0)
+      queue.async {
+        // Nothing is waiting for a request that timed out before its turn.
+        if !results.isFinished {
+          completion(arguments, results)
+        }
+        finished.signal()
+      }
+      _ = finished.wait(timeout: .now() + timeout)
+      return results.finish()
+    })
+  }
+}
+
+/// The serial queues that timed completion closures run on, one for each
+/// argument that has one.
+private let timedCompletionQueues = SynchronizedCache<CompletionKind.CompletionSite, DispatchQueue>()
+
+/// A collection of completions that a custom completion closure builds up
+/// over time.
+///
+/// You can add completions from any thread.
+public final class CompletionResults {
+  private var values: [String] = []
+  private var _isFinished = false
+  private let lock = NSLock()
+  
+  init() {}
+  
+  /// Adds a completion.
+  public func append(_ value: String) {
+    append(contentsOf: CollectionOfOne(value))
+  }
+  
+  /// Adds a sequence of completions.
+  public func append<S: Sequence>(contentsOf values: S) where S.Element == String {
+    lock.lock()
+    defer { lock.unlock() }
+    guard !_isFinished else { return }
+    self.values.append(contentsOf: values)
+  }
+  
+  /// A Boolean value indicating whether the shell has already received the
+  /// completions.
+  var isFinished: Bool {
+    lock.lock()
+    defer { lock.unlock() }
+    return _isFinished
+  }
+  
+  /// Returns the completions added so far, and ignores any added afterward.
+  func finish() -> [String] {
+    lock.lock()
+    defer { lock.unlock() }
+    _isFinished = true
+    return values
   }
 }
@@ -424,6 +424,7 @@ extension Option {
     initial: [Element]?,
     name: NameSpecification,
     parsingStrategy: ArrayParsingStrategy,
+    conversionStrategy: ArrayConversionStrategy,
     help: ArgumentHelp?,
     completion: CompletionKind?
   ) where Element: ExpressibleByArgument, Value == Array<Element> {
@@ -452,6 +453,9 @@ extension Option {
         initial: setInitialValue
       )
       arg.help.defaultValue = helpDefaultValue
+      if conversionStrategy.isConcurrent {
+        arg.convertValuesConcurrently(forKey: key) { Element(argument: $0) }
+      }
       return ArgumentSet(arg)
     })
   }
@@ -464,11 +468,14 @@ extension Option {
   ///   - initial: A default value to use for this property.
   ///   - parsingStrategy: The behavior to use when parsing multiple values
   ///     from the command-line arguments.
+  ///   - conversionStrategy: The behavior to use when converting the
+  ///     values to the element type.
   ///   - help: Information about how to use this option.
   public init<Element>(
     wrappedValue: [Element],
     name: NameSpecification = .long,
     parsing parsingStrategy: ArrayParsingStrategy = .singleValue,
+    conversion conversionStrategy: ArrayConversionStrategy = .serial,
     help: ArgumentHelp? = nil,
     completion: CompletionKind? = nil
   ) where Element: ExpressibleByArgument, Value == Array<Element> {
@@ -476,6 +483,7 @@ extension Option {
       initial: wrappedValue,
       name: name,
       parsingStrategy: parsingStrategy,
+      conversionStrategy: conversionStrategy,
       help: help,
       completion: completion
     )
@@ -492,10 +500,12 @@ extension Option {
   /// - Parameters:
   ///   - name: A specification for what names are allowed for this flag.
   ///   - parsingStrategy: The behavior to use when parsing multiple values from the command-line arguments.
+  ///   - conversionStrategy: The behavior to use when converting the values to the element type.
   ///   - help: Information about how to use this option.
   public init<Element>(
     name: NameSpecification = .long,
     parsing parsingStrategy: ArrayParsingStrategy = .singleValue,
+    conversion conversionStrategy: ArrayConversionStrategy = .serial,
     help: ArgumentHelp? = nil,
     completion: CompletionKind? = nil
   ) where Element: ExpressibleByArgument, Value == Array<Element> {
@@ -503,6 +513,7 @@ extension Option {
       initial: nil,
       name: name,
       parsingStrategy: parsingStrategy,
+      conversionStrategy: conversionStrategy,
       help: help,
       completion: completion
     )
@@ -516,6 +527,7 @@ extension Option {
     initial: [Element]?,
     name: NameSpecification,
     parsingStrategy: ArrayParsingStrategy,
+    conversionStrategy: ArrayConversionStrategy,
     help: ArgumentHelp?,
     completion: CompletionKind?,
     transform: @escaping (String) throws -> Element
@@ -554,6 +566,9 @@ extension Option {
         initial: setInitialValue
       )
       arg.help.defaultValue = helpDefaultValue
+      if conversionStrategy.isConcurrent {
+        arg.convertValuesConcurrently(forKey: key, transform)
+      }
       return ArgumentSet(arg)
     })
   }
@@ -570,6 +585,8 @@ extension Option {
   ///     `nil`, this option defaults to an empty array.
   ///   - parsingStrategy: The behavior to use when parsing multiple values
   ///     from the command-line arguments.
+  ///   - conversionStrategy: The behavior to use when converting the
+  ///     values to the element type.
   ///   - help: Information about how to use this option.
   ///   - transform: A closure that converts a string into this property's
   ///     element type or throws an error.
@@ -577,6 +594,7 @@ extension Option {
     wrappedValue: [Element],
     name: NameSpecification = .long,
     parsing parsingStrategy: ArrayParsingStrategy = .singleValue,
+    conversion conversionStrategy: ArrayConversionStrategy = .serial,
     help: ArgumentHelp? = nil,
     completion: CompletionKind? = nil,
     transform: @escaping (String) throws -> Element
@@ -585,6 +603,7 @@ extension Option {
       initial: wrappedValue,
       name: name,
       parsingStrategy: parsingStrategy,
+      conversionStrategy: conversionStrategy,
       help: help,
       completion: completion,
       transform: transform
@@ -602,11 +621,13 @@ extension Option {
   /// - Parameters:
   ///   - name: A specification for what names are allowed for this flag.
   ///   - parsingStrategy: The behavior to use when parsing multiple values from the command-line arguments.
+  ///   - conversionStrategy: The behavior to use when converting the values to the element type.
   ///   - help: Information about how to use this option.
   ///   - transform: A closure that converts a string into this property's element type or throws an error.
   public init<Element>(
     name: NameSpecification = .long,
     parsing parsingStrategy: ArrayParsingStrategy = .singleValue,
+    conversion conversionStrategy: ArrayConversionStrategy = .serial,
     help: ArgumentHelp? = nil,
     completion: CompletionKind? = nil,
     transform: @escaping (String) throws -> Element
@@ -615,6 +636,7 @@ extension Option {
       initial: nil,
       name: name,
       parsingStrategy: parsingStrategy,
+      conversionStrategy: conversionStrategy,
       help: help,
       completion: completion,
       transform: transform
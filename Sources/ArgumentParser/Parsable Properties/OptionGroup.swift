@@ -28,10 +28,16 @@
 ///
 /// The flag and positional arguments declared as part of `GlobalOptions` are
 /// included when parsing `Options`.
+///
+/// When you declare an option group with `@OptionGroup(lazy: true)`, its
+/// values are only recorded during parsing. Conversion, decoding, and
+/// validation happen the first time you access the wrapped value, so a
+/// command doesn't pay for a large group that its `run()` method never uses.
 @propertyWrapper
 public struct OptionGroup<Value: ParsableArguments>: Decodable, ParsedWrapper {
   internal var _parsedValue: Parsed<Value>
   internal var _hiddenFromHelp: Bool = false
+  internal var _lazyValue: LazyDecodedArguments<Value>? = nil
   
   internal init(_parsedValue: Parsed<Value>) {
     self._parsedValue = _parsedValue
@@ -42,6 +48,17 @@ public struct OptionGroup<Value: ParsableArguments>: Decodable, ParsedWrapper {
       let value = try? d.previousValue(Value.self)
     {
       self.init(_parsedValue: .value(value))
+    } else if let d = decoder as? SingleValueDecoder,
+      let input = d.parsedElement?.value as? RecordedInput
+    {
+      // A lazy group is decoded on first access, and so isn't saved for
+      // option groups of the same type in subcommands.
+      self.init(_parsedValue: .init { _ in ArgumentSet() })
+      self._lazyValue = LazyDecodedArguments(
+        input: input,
+        originalInput: d.underlying.values.originalInput,
+        commandStack: d.underlying.commandStack)
+      return
     } else {
       try self.init(_decoder: decoder)
       if let d = decoder as? SingleValueDecoder {
@@ -63,6 +80,25 @@ public struct OptionGroup<Value: ParsableArguments>: Decodable, ParsedWrapper {
     })
   }
 
+  /// Creates a property that represents another parsable type, and that
+  /// optionally defers decoding it until the property is first accessed.
+  ///
+  /// If any of the group's values are invalid, the error is reported when
+  /// the property is first accessed, with the message and usage of the
+  /// command that was parsed, and the program exits. To handle the error
+  /// yourself instead, such as in a process that parses many command lines,
+  /// read the group with `try $property.value()`.
+  ///
+  /// - Parameter lazy: Whether to decode and validate the group on first
+  ///   access, instead of while parsing.
+  public init(lazy: Bool) {
+    self.init(_parsedValue: .init { key in
+      lazy
+        ? ArgumentSet(Value.self).recordingInput(forKey: key)
+        : ArgumentSet(Value.self)
+    })
+  }
+
   /// The value presented by this property wrapper.
   public var wrappedValue: Value {
     get {
@@ -70,11 +106,42 @@ public struct OptionGroup<Value: ParsableArguments>: Decodable, ParsedWrapper {
       case .value(let v):
         return v
       case .definition:
-        fatalError(directlyInitializedError)
+        do {
+          return try value()
+        } catch {
+          _lazyValue!.rootCommand.exit(withError: error)
+        }
       }
     }
     set {
       _parsedValue = .value(newValue)
+      _lazyValue = nil
+    }
+  }
+
+  /// This property wrapper, for reading a lazy group's value with
+  /// `value()`.
+  public var projectedValue: OptionGroup<Value> {
+    self
+  }
+
+  /// Returns the value of this property, throwing any error in a lazy
+  /// group's values instead of exiting.
+  ///
+  /// A lazy group's values are decoded and validated the first time they're
+  /// read, and the same value or error is returned after that. Errors have
+  /// the same message and usage as errors found while parsing, so you can
+  /// pass them to the root command's `fullMessage(for:)` or
+  /// `exit(withError:)`.
+  public func value() throws -> Value {
+    switch _parsedValue {
+    case .value(let v):
+      return v
+    case .definition:
+      guard let lazyValue = _lazyValue else {
+        fatalError(directlyInitializedError)
+      }
+      return try lazyValue.value()
     }
   }
 }
@@ -84,6 +151,8 @@ extension OptionGroup: CustomStringConvertible {
     switch _parsedValue {
     case .value(let v):
       return String(describing: v)
+    case .definition where _lazyValue != nil:
+      return "OptionGroup(*lazy*)"
     case .definition:
       return "OptionGroup(*definition*)"
     }
@@ -0,0 +1,198 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+#if compiler(>=5.6) && canImport(_Concurrency)
+
+@_implementationOnly import Foundation
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#elseif canImport(CRT)
+import CRT
+#endif
+
+/// A type that can be executed asynchronously, as part of a nested tree of
+/// commands.
+///
+/// Use `AsyncParsableCommand` for commands that do their work with Swift
+/// concurrency, and call the asynchronous `main()` method on the root
+/// command:
+///
+///     @main
+///     struct Fetch: AsyncParsableCommand {
+///         @Argument var urls: [String]
+///
+///         mutating func run() async throws {
+///             try await withThrowingTaskGroup(of: Void.self) { group in
+///                 for url in urls {
+///                     group.addTask { try await download(url) }
+///                 }
+///                 try await group.waitForAll()
+///             }
+///         }
+///     }
+///
+/// The subcommands of an asynchronous root command can be any mix of
+/// `ParsableCommand` and `AsyncParsableCommand` types. An asynchronous
+/// subcommand must have an asynchronous root, because only the asynchronous
+/// `main()` can call an asynchronous `run()`; the synchronous `main()`
+/// reports an error instead of running an asynchronous subcommand.
+///
+/// `AsyncParsableCommand` requires Swift 5.6 or later, where `@main`
+/// calls the asynchronous `main()`.
+@available(macOS 10.15, macCatalyst 13, iOS 13, tvOS 13, watchOS 6, *)
+public protocol AsyncParsableCommand: ParsableCommand {
+  /// Runs this command asynchronously.
+  ///
+  /// This method has a default implementation that prints help text for
+  /// this command.
+  ///
+  /// When the process receives `SIGINT` or `SIGTERM` while this method is
+  /// running, the task that runs it is cancelled. If the method ends by
+  /// throwing `CancellationError`, the process exits with the conventional
+  /// status for that signal. A second signal terminates the process
+  /// immediately.
+  mutating func run() async throws
+}
+
+@available(macOS 10.15, macCatalyst 13, iOS 13, tvOS 13, watchOS 6, *)
+extension AsyncParsableCommand {
+  public mutating func run() async throws {
+    throw CleanExit.helpRequest(self)
+  }
+  
+  /// Parses an instance of this type, or one of its subcommands, from
+  /// the given arguments and calls its `run()` method, exiting with a
+  /// relevant error message if necessary.
+  ///
+  /// - Parameter arguments: An array of arguments to use for parsing. If
+  ///   `arguments` is `nil`, this uses the program's command-line arguments.
+  public static func main(_ arguments: [String]?) async {
+    let cancellation = SignalCancellation()
+    do {
+      try await run(parseAsRoot(arguments), cancellation: cancellation)
+    } catch is CancellationError where cancellation.receivedSignal != nil {
+      exit(withError: ExitCode(128 + cancellation.receivedSignal!))
+    } catch {
+      exit(withError: error)
+    }
+  }
+
+  /// Parses an instance of this type, or one of its subcommands, from
+  /// command-line arguments and calls its `run()` method, exiting with a
+  /// relevant error message if necessary.
+  public static func main() async {
+    await self.main(nil)
+  }
+
+  /// Runs a parsed command, awaiting its `run()` method if it's
+  /// asynchronous, in a task that `cancellation` cancels.
+  static func run(
+    _ command: ParsableCommand,
+    cancellation: SignalCancellation? = nil
+  ) async throws {
+    guard let asyncCommand = command as? AsyncParsableCommand else {
+      var command = command
+      try command.run()
+      return
+    }
+
+    let task = Task { () -> Void in
+      var asyncCommand = asyncCommand
+      try await asyncCommand.run()
+    }
+    cancellation?.begin(cancelling: task)
+    defer { cancellation?.end() }
+    
+    // Cancelling the caller's task cancels the command, too.
+    #if compiler(>=5.7)
+    try await withTaskCancellationHandler {
+      try await task.value
+    } onCancel: {
+      task.cancel()
+    }
+    #else
+    try await withTaskCancellationHandler(
+      handler: { task.cancel() },
+      operation: { try await task.value })
+    #endif
+  }
+}
+
+/// Cancels a task when the process receives `SIGINT` or `SIGTERM`.
+@available(macOS 10.15, macCatalyst 13, iOS 13, tvOS 13, watchOS 6, *)
+final class SignalCancellation {
+  private let lock = NSLock()
+  private var caughtSignal: Int32?
+
+  #if !os(Windows)
+  private var sources: [DispatchSourceSignal] = []
+
+  /// The handling of each signal before `begin(cancelling:)`, which `end()`
+  /// restores.
+  private var previousHandlers: [(signal: Int32, handler: (@convention(c) (Int32) -> Void)?)] = []
+  #endif
+
+  /// The first signal that was received while a task was running, if any.
+  var receivedSignal: Int32? {
+    lock.lock()
+    defer { lock.unlock() }
+    return caughtSignal
+  }
+
+  init() {}
+
+  func begin(cancelling task: Task<Void, Error>) {
+    #if !os(Windows)
+    sources = [SIGINT, SIGTERM].map { signalNumber in
+      // Dispatch only sees signals that don't have a handler of their own.
+      previousHandlers.append((signalNumber, signal(signalNumber, SIG_IGN)))
+      let source = DispatchSource.makeSignalSource(signal: signalNumber, queue: .global())
+      source.setEventHandler { [unowned self] in
+        self.lock.lock()
+        let isFirstSignal = self.caughtSignal == nil
+        if isFirstSignal {
+          self.caughtSignal = signalNumber
+        }
+        self.lock.unlock()
+
+        if isFirstSignal {
+          task.cancel()
+        } else {
+          // The command didn't stop after being cancelled, so let the
+          // signal terminate the process as usual.
+          signal(signalNumber, SIG_DFL)
+          kill(getpid(), signalNumber)
+        }
+      }
+      source.resume()
+      return source
+    }
+    #endif
+  }
+
+  func end() {
+    #if !os(Windows)
+    for source in sources {
+      source.cancel()
+    }
+    sources = []
+    for (signalNumber, handler) in previousHandlers {
+      signal(signalNumber, handler)
+    }
+    previousHandlers = []
+    #endif
+  }
+}
+
+#endif
@@ -47,6 +47,33 @@ public struct CommandConfiguration {
   /// Flag names to be used for help.
   public var helpNames: NameSpecification?
   
+  /// A Boolean value indicating whether users can abbreviate this command's
+  /// options and flags to any unambiguous prefix of their `--`-prefixed
+  /// names, such as `--verb` for `--verbose`.
+  public var allowsAbbreviatedNames: Bool
+  
+  /// The sources, besides the command line, to read option and flag values
+  /// from, in order of precedence.
+  ///
+  /// A command without value sources uses those of its nearest ancestor.
+  public var valueSources: [ValueSource]
+  
+  /// A Boolean value indicating whether an `@path` argument is replaced by
+  /// the arguments listed in the file at `path`.
+  ///
+  /// Only the root command's setting is used.
+  public var allowsResponseFiles: Bool
+  
+  /// A Boolean value indicating whether the generated Bash and Zsh
+  /// completion scripts define only the root command's completions, and load
+  /// each subcommand's completions from the command the first time they're
+  /// needed.
+  ///
+  /// Turn this on for commands with many subcommands, so that the time a
+  /// shell spends loading the completion script doesn't grow with the size
+  /// of the command tree. Only the root command's setting is used.
+  public var lazilyLoadsSubcommandCompletions: Bool
+  
   /// Creates the configuration for a command.
   ///
   /// - Parameters:
@@ -68,6 +95,19 @@ public struct CommandConfiguration {
   ///     with a simulated Boolean property named `help`. If `helpNames` is
   ///     `nil`, the names are inherited from the parent command, if any, or
   ///     `-h` and `--help`.
+  ///   - allowsAbbreviatedNames: A Boolean value indicating whether users
+  ///     can abbreviate options and flags to an unambiguous prefix of their
+  ///     `--`-prefixed names.
+  ///   - valueSources: The sources, besides the command line, to read
+  ///     option and flag values from, in order of precedence. If
+  ///     `valueSources` is empty, the sources are inherited from the parent
+  ///     command, if any.
+  ///   - allowsResponseFiles: A Boolean value indicating whether an `@path`
+  ///     argument is replaced by the arguments listed in the file at `path`.
+  ///     Only the root command's setting is used.
+  ///   - lazilyLoadsSubcommandCompletions: A Boolean value indicating whether
+  ///     completion scripts load each subcommand's completions the first time
+  ///     they're needed. Only the root command's setting is used.
   public init(
     commandName: String? = nil,
     abstract: String = "",
@@ -76,7 +116,11 @@ public struct CommandConfiguration {
     shouldDisplay: Bool = true,
     subcommands: [ParsableCommand.Type] = [],
     defaultSubcommand: ParsableCommand.Type? = nil,
-    helpNames: NameSpecification? = nil
+    helpNames: NameSpecification? = nil,
+    allowsAbbreviatedNames: Bool = false,
+    valueSources: [ValueSource] = [],
+    allowsResponseFiles: Bool = false,
+    lazilyLoadsSubcommandCompletions: Bool = false
   ) {
     self.commandName = commandName
     self.abstract = abstract
@@ -86,6 +130,10 @@ public struct CommandConfiguration {
     self.subcommands = subcommands
     self.defaultSubcommand = defaultSubcommand
     self.helpNames = helpNames
+    self.allowsAbbreviatedNames = allowsAbbreviatedNames
+    self.valueSources = valueSources
+    self.allowsResponseFiles = allowsResponseFiles
+    self.lazilyLoadsSubcommandCompletions = lazilyLoadsSubcommandCompletions
   }
 
   /// Creates the configuration for a command with a "super-command".
@@ -99,7 +147,11 @@ public struct CommandConfiguration {
     shouldDisplay: Bool = true,
     subcommands: [ParsableCommand.Type] = [],
     defaultSubcommand: ParsableCommand.Type? = nil,
-    helpNames: NameSpecification? = nil
+    helpNames: NameSpecification? = nil,
+    allowsAbbreviatedNames: Bool = false,
+    valueSources: [ValueSource] = [],
+    allowsResponseFiles: Bool = false,
+    lazilyLoadsSubcommandCompletions: Bool = false
   ) {
     self.commandName = commandName
     self._superCommandName = _superCommandName
@@ -110,5 +162,9 @@ public struct CommandConfiguration {
     self.subcommands = subcommands
     self.defaultSubcommand = defaultSubcommand
     self.helpNames = helpNames
+    self.allowsAbbreviatedNames = allowsAbbreviatedNames
+    self.valueSources = valueSources
+    self.allowsResponseFiles = allowsResponseFiles
+    self.lazilyLoadsSubcommandCompletions = lazilyLoadsSubcommandCompletions
   }
 }
@@ -0,0 +1,112 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// A parser for a root command that you can reuse to parse many different
+/// sets of command-line arguments.
+///
+/// Creating a `CommandLineParser` does all of the work of preparing a command
+/// tree for parsing up front, including building the arguments of commands
+/// whose `cachesArgumentDefinitions` is `true`, so that each call to
+/// `parse(_:)` only has to process its arguments. A parser has no mutable
+/// state, so you can share a single instance and call `parse(_:)` from
+/// multiple threads at once.
+///
+/// Use a `CommandLineParser` when a long-running process parses many
+/// command lines, such as a server or an interactive shell:
+///
+///     let parser = CommandLineParser(rootCommand: Math.self)
+///
+///     func handle(request arguments: [String]) -> String {
+///         do {
+///             var command = try parser.parse(arguments)
+///             try command.run()
+///             return "OK"
+///         } catch {
+///             return parser.fullMessage(for: error)
+///         }
+///     }
+public struct CommandLineParser {
+  private let commandTree: Tree<ParsableCommand.Type>
+  
+  /// The root command of this parser.
+  public var rootCommand: ParsableCommand.Type {
+    commandTree.element
+  }
+  
+  /// Creates a parser for the given root command and its subcommands.
+  ///
+  /// - Parameter rootCommand: The root of the command tree to parse.
+  public init(rootCommand: ParsableCommand.Type) {
+    self.commandTree = CommandParser.commandTree(for: rootCommand)
+    
+    // Build the argument set for each command in the tree that caches it,
+    // so that the first call to `parse(_:)` doesn't pay that cost.
+    func prepare(_ node: Tree<ParsableCommand.Type>) {
+      if node.element.cachesArgumentDefinitions {
+        _ = ArgumentSet(node.element)
+      }
+      node.children.forEach(prepare)
+    }
+    prepare(commandTree)
+    _ = ArgumentSet(GenerateCompletions.self)
+    _ = ArgumentSet(AutodetectedGenerateCompletions.self)
+    _ = ArgumentSet(GenerateCompletionShim.self)
+    _ = ArgumentSet(AutodetectedGenerateCompletionShim.self)
+  }
+  
+  /// Parses an instance of the root command, or one of its subcommands, from
+  /// the given arguments.
+  ///
+  /// This is equivalent to calling `parseAsRoot(_:)` on the root command type,
+  /// and throws the same errors. Pass any error thrown by this method to
+  /// `fullMessage(for:)` or `exitCode(for:)` to get a message or exit code
+  /// for the error.
+  ///
+  /// Unlike `parseAsRoot(_:)`, this method doesn't answer the requests that
+  /// generated completion scripts make, such as `---completion`, and
+  /// throws an error for them instead.
+  ///
+  /// - Parameter arguments: An array of arguments to parse. This should not
+  ///   include the command name as the first argument.
+  /// - Returns: A new instance of the root command or one of its
+  ///   subcommands, or a command type internal to the `ArgumentParser`
+  ///   library.
+  public func parse(_ arguments: [String]) throws -> ParsableCommand {
+    var parser = CommandParser(commandTree: commandTree)
+    parser.handlesCompletionRequests = false
+    return try parser.parse(arguments: arguments).get()
+  }
+  
+  /// Returns a full message for the given error, including usage information,
+  /// if appropriate.
+  ///
+  /// - Parameter error: An error thrown by `parse(_:)`, or by the `run()`
+  ///   or `validate()` method of a parsed command.
+  /// - Returns: A message that can be displayed to the user.
+  public func fullMessage(for error: Error) -> String {
+    rootCommand.fullMessage(for: error)
+  }
+  
+  /// Returns the exit code for the given error.
+  ///
+  /// - Parameter error: An error thrown by `parse(_:)`, or by the `run()`
+  ///   or `validate()` method of a parsed command.
+  /// - Returns: The exit code for `error`.
+  public func exitCode(for error: Error) -> ExitCode {
+    rootCommand.exitCode(for: error)
+  }
+}
+
+#if compiler(>=5.5)
+// The command tree is never modified after it's built, and all of the
+// parser's caches are synchronized.
+extension CommandLineParser: @unchecked Sendable {}
+#endif
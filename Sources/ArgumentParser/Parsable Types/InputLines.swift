@@ -0,0 +1,260 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#elseif canImport(CRT)
+import CRT
+#endif
+
+/// A sequence of the lines in a file, or in standard input, that is read
+/// lazily as you iterate.
+///
+/// Use `InputLines` as the type of an option or argument when a command
+/// accepts more values than fit on a command line, such as a list of paths
+/// produced by another tool. The command line holds only the file's path,
+/// or `-` to read from standard input, and the lines are read one at a time
+/// during iteration, so memory use stays flat regardless of the input size:
+///
+///     struct Archive: ParsableCommand {
+///         @Option(name: .customLong("files-from"),
+///                 help: "A file listing one path per line, or '-' for stdin.")
+///         var files: InputLines
+///
+///         mutating func run() throws {
+///             for path in files {
+///                 try add(path)
+///             }
+///         }
+///     }
+///
+/// Each line is delivered without its trailing newline (`\n` or `\r\n`).
+/// To read entries that end with a different byte, such as the NUL bytes
+/// that `find -print0` writes, use `separated(by:)` as the property's
+/// transform:
+///
+///     @Option(name: .customLong("files-from"), transform: InputLines.separated(by: 0))
+///     var files: InputLines
+///
+/// Every call to `makeIterator()` reads the file again from the beginning,
+/// except when reading from standard input, which can only be consumed once.
+/// If the file can no longer be opened when iteration begins, for example
+/// because it was removed after parsing, `makeIterator()` stops the program
+/// with an error message; call `open()` instead to handle that error.
+public struct InputLines: Sequence {
+  /// The path to the file, or `-` for standard input.
+  public var path: String
+
+  /// The byte that ends each line.
+  ///
+  /// When the separator is a newline, a carriage return before it is also
+  /// removed.
+  public var separator: UInt8
+
+  /// A Boolean value indicating whether the lines are read from standard
+  /// input.
+  public var isStandardInput: Bool {
+    path == "-"
+  }
+
+  /// Creates a sequence of the lines in the file at `path`.
+  ///
+  /// Pass `-` to read from standard input. The file isn't opened until you
+  /// begin iterating.
+  ///
+  /// - Parameters:
+  ///   - path: The path to the file, or `-` for standard input.
+  ///   - separator: The byte that ends each line.
+  public init(path: String, separator: UInt8 = UInt8(ascii: "\n")) {
+    self.path = path
+    self.separator = separator
+  }
+
+  /// Returns a transform that creates a sequence of the entries ending with
+  /// `separator` in the file named by a command-line argument.
+  ///
+  /// Like `init(argument:)`, the transform reports a file that can't be
+  /// opened for reading as an invalid value.
+  public static func separated(by separator: UInt8) -> (String) throws -> InputLines {
+    return { argument in
+      guard var lines = InputLines(argument: argument) else {
+        throw ValidationError("Couldn't open '\(argument)' for reading.")
+      }
+      lines.separator = separator
+      return lines
+    }
+  }
+
+  /// Opens the file and returns an iterator over its lines, throwing an
+  /// error if the file can't be opened.
+  public func open() throws -> Iterator {
+    if isStandardInput {
+      return Iterator(handle: LineReader.standardInput(separator: separator))
+    }
+    guard let file = fopen(path, "r") else {
+      throw OpenError(path: path, code: errno)
+    }
+    return Iterator(handle: LineReader(file: file, closesFile: true, separator: separator))
+  }
+
+  public func makeIterator() -> Iterator {
+    do {
+      return try open()
+    } catch {
+      fatalError("\(error)")
+    }
+  }
+
+  /// An iterator that reads one line at a time.
+  ///
+  /// An iterator is also a sequence of the lines it hasn't read yet, so you
+  /// can write `for line in try lines.open()`.
+  public struct Iterator: IteratorProtocol, Sequence {
+    fileprivate var handle: LineReader?
+
+    public mutating func next() -> String? {
+      guard let line = handle?.nextLine() else {
+        handle = nil
+        return nil
+      }
+      return line
+    }
+  }
+
+  /// An error that describes why a file couldn't be opened.
+  public struct OpenError: Error, CustomStringConvertible {
+    /// The path of the file.
+    public var path: String
+
+    /// The `errno` value that opening the file produced.
+    public var code: Int32
+
+    public var description: String {
+      "Couldn't open '\(path)' for reading: \(String(cString: strerror(code)))"
+    }
+  }
+}
+
+extension InputLines: ExpressibleByArgument {
+  /// Creates a sequence of lines from a command-line argument, which is
+  /// either a path to a readable file or `-` for standard input.
+  ///
+  /// Returns `nil` if the file can't be opened for reading.
+  public init?(argument: String) {
+    if argument != "-" {
+      guard let file = fopen(argument, "r") else { return nil }
+      fclose(file)
+    }
+    self.init(path: argument)
+  }
+
+  public var defaultValueDescription: String {
+    path
+  }
+
+  public static var defaultCompletionKind: CompletionKind {
+    .file()
+  }
+}
+
+// MARK: - Reading
+
+/// An open file that is closed when the reader is released.
+fileprivate final class LineReader {
+  private var file: UnsafeMutablePointer<FILE>?
+  private let closesFile: Bool
+  private let separator: UInt8
+
+  #if !os(Windows)
+  /// The buffer that `getdelim` reads into, reused and grown as needed for
+  /// every line.
+  private var buffer: UnsafeMutablePointer<CChar>?
+  private var capacity = 0
+  #endif
+
+  init(file: UnsafeMutablePointer<FILE>?, closesFile: Bool, separator: UInt8) {
+    self.file = file
+    self.closesFile = closesFile
+    self.separator = separator
+  }
+
+  /// Returns a reader for standard input, which is never closed.
+  static func standardInput(separator: UInt8) -> LineReader {
+    #if os(Windows)
+    return LineReader(file: __acrt_iob_func(0), closesFile: false, separator: separator)
+    #else
+    return LineReader(file: stdin, closesFile: false, separator: separator)
+    #endif
+  }
+
+  deinit {
+    close()
+    #if !os(Windows)
+    free(buffer)
+    #endif
+  }
+
+  private func close() {
+    if closesFile, let file = file {
+      fclose(file)
+    }
+    file = nil
+  }
+
+  /// Returns the next line without its separator, or `nil` at the end of
+  /// the file.
+  ///
+  /// Lines are measured by the number of bytes read rather than by a
+  /// terminating NUL, so a line can contain NUL bytes, and NUL can be the
+  /// separator.
+  func nextLine() -> String? {
+    guard let file = file else { return nil }
+
+    #if os(Windows)
+    var line: [UInt8] = []
+    var character = fgetc(file)
+    while character != EOF, UInt8(truncatingIfNeeded: character) != separator {
+      line.append(UInt8(truncatingIfNeeded: character))
+      character = fgetc(file)
+    }
+    let hasSeparator = character != EOF
+    if !hasSeparator {
+      // The last line may not end with a separator.
+      close()
+      if line.isEmpty { return nil }
+    }
+    return decode(line[...], hasSeparator: hasSeparator)
+    #else
+    let count = getdelim(&buffer, &capacity, Int32(separator), file)
+    guard count >= 0, let buffer = buffer else {
+      close()
+      return nil
+    }
+    let bytes = UnsafeBufferPointer(
+      start: UnsafeRawPointer(buffer).assumingMemoryBound(to: UInt8.self),
+      count: count)
+    let hasSeparator = bytes.last == separator
+    return decode(hasSeparator ? bytes.dropLast() : bytes[...], hasSeparator: hasSeparator)
+    #endif
+  }
+
+  /// Decodes a line that has had its separator, if any, removed.
+  private func decode<Bytes: BidirectionalCollection>(_ line: Bytes, hasSeparator: Bool) -> String
+    where Bytes.Element == UInt8, Bytes.SubSequence == Bytes
+  {
+    if hasSeparator, separator == UInt8(ascii: "\n"), line.last == UInt8(ascii: "\r") {
+      return String(decoding: line.dropLast(), as: UTF8.self)
+    }
+    return String(decoding: line, as: UTF8.self)
+  }
+}
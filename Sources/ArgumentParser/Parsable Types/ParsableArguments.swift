@@ -37,6 +37,21 @@ public protocol ParsableArguments: Decodable {
   
   /// The label to use for "Error: ..." messages from this type. (experimental)
   static var _errorLabel: String { get }
+  
+  /// A Boolean value indicating whether the definitions of this type's
+  /// arguments can be built once and reused for the rest of the process.
+  ///
+  /// By default, the library creates a new instance of a type and reflects
+  /// over its properties each time it needs the type's arguments, so that
+  /// each parse uses the default values of a new instance. Return `true` to
+  /// reflect over the type only once, in a process that parses many command
+  /// lines or for a type with many arguments, when every default value of
+  /// the type and its option groups is the same for each instance. A default
+  /// like `UUID().uuidString` or `Date()` would otherwise be reused for every
+  /// parse. When every command in a command stack returns `true`, the
+  /// information that its help screen and help dumps are built from is
+  /// reused as well.
+  static var cachesArgumentDefinitions: Bool { get }
 }
 
 /// A type that provides the `ParsableCommand` interface to a `ParsableArguments` type.
@@ -56,6 +71,10 @@ struct _WrappedParsableCommand<P: ParsableArguments>: ParsableCommand {
   }
   
   @OptionGroup var options: P
+  
+  static var cachesArgumentDefinitions: Bool {
+    P.cachesArgumentDefinitions
+  }
 }
 
 struct StandardError: TextOutputStream {
@@ -66,6 +85,14 @@ struct StandardError: TextOutputStream {
 
 var standardError = StandardError()
 
+struct StandardOutput: TextOutputStream {
+  mutating func write(_ string: String) {
+    print(string, terminator: "")
+  }
+}
+
+var standardOutput = StandardOutput()
+
 extension ParsableArguments {
   public mutating func validate() throws {}
   
@@ -78,6 +105,10 @@ extension ParsableArguments {
   public static var _errorLabel: String {
     "Error"
   }
+  
+  public static var cachesArgumentDefinitions: Bool {
+    false
+  }
 }
 
 // MARK: - API
@@ -138,11 +169,39 @@ extension ParsableArguments {
   ///   or a default value of `80` if the terminal width is not available.
   /// - Returns: The full help screen for this type.
   public static func helpMessage(columns: Int? = nil) -> String {
-    HelpGenerator(self).rendered(screenWidth: columns)
+    HelpGenerator.rendered(commandStack: [self.asCommand], screenWidth: columns)
+  }
+  
+  /// Writes the help screen for this type to the given output stream.
+  ///
+  /// The help screen is written section by section as it's rendered, instead
+  /// of being built as a single string first, so output can start arriving
+  /// at a pipe or pager immediately.
+  ///
+  /// - Parameters:
+  ///   - output: The stream to write the help screen to.
+  ///   - columns: The column width to use when wrapping long lines in the
+  ///     help screen. If `columns` is `nil`, uses the current terminal
+  ///     width, or a default value of `80` if the terminal width is not
+  ///     available.
+  public static func writeHelpMessage<Target: TextOutputStream>(
+    to output: inout Target,
+    columns: Int? = nil
+  ) {
+    HelpGenerator(commandStack: [self.asCommand])
+      .render(screenWidth: columns, to: &output)
   }
   
   public static func dumpMessage(columns: Int? = nil) -> String {
-    DumpHelpInfoGenerator(self).rendered()
+    DumpHelpInfoGenerator.rendered(commandStack: [self.asCommand])
+  }
+
+  /// Returns the compact help dump for this type, as printed by
+  /// `--dump-help-compact`.
+  ///
+  /// Use `HelpInfo(compactDump:)` to read the returned dump.
+  public static func compactDumpMessage() -> String {
+    DumpHelpInfoGenerator.renderedCompact(commandStack: [self.asCommand])
   }
 
   /// Returns the exit code for the given error.
@@ -167,6 +226,17 @@ extension ParsableArguments {
     return completionsGenerator.generateCompletionScript()
   }
 
+  /// Returns a shell snippet that loads this command's completion script
+  /// from a cache, regenerating the cached script only when the command's
+  /// version or executable changes.
+  ///
+  /// - Parameter shell: The shell to generate a completion shim for.
+  /// - Returns: The completion shim for `shell`.
+  public static func completionShim(for shell: CompletionShell) -> String {
+    let completionsGenerator = try! CompletionsGenerator(command: self.asCommand, shell: shell)
+    return completionsGenerator.generateCompletionShim()
+  }
+
   /// Terminates execution with a message and exit code that is appropriate
   /// for the given error.
   ///
@@ -185,13 +255,10 @@ extension ParsableArguments {
     }
     
     let messageInfo = MessageInfo(error: error, type: self)
-    let fullText = messageInfo.fullText(for: self)
-    if !fullText.isEmpty {
-      if messageInfo.shouldExitCleanly {
-        print(fullText)
-      } else {
-        print(fullText, to: &standardError)
-      }
+    if messageInfo.shouldExitCleanly {
+      messageInfo.write(for: self, to: &standardOutput)
+    } else {
+      messageInfo.write(for: self, to: &standardError)
     }
     _exit(messageInfo.exitCode.rawValue)
   }
@@ -237,9 +304,53 @@ protocol ArgumentSetProvider {
   var _hiddenFromHelp: Bool { get }
 }
 
+/// The key for a cached argument set.
+private struct ArgumentSetCacheKey: Hashable {
+  var type: ObjectIdentifier
+  var creatingHelp: Bool
+}
+
+/// Argument sets that have already been built by reflecting over a type.
+///
+/// Building an argument set requires creating an instance of the type and
+/// walking its properties, so for types that opt in with
+/// `cachesArgumentDefinitions`, this is only done once per type for the life
+/// of the process.
+private let argumentSetCache = SynchronizedCache<ArgumentSetCacheKey, ArgumentSet>()
+
 extension ArgumentSet {
   init(_ type: ParsableArguments.Type, creatingHelp: Bool = false) {
-    
+    let cacheKey = ArgumentSetCacheKey(type: ObjectIdentifier(type), creatingHelp: creatingHelp)
+    if type.cachesArgumentDefinitions, let cached = argumentSetCache[cacheKey] {
+      self = cached
+      return
+    }
+
+    let argumentSet = traced(.argumentSet, command: type.traceName, if: !(type is PseudoCommand.Type)) {
+      ArgumentSet.reflecting(type, creatingHelp: creatingHelp)
+    }
+    if type.cachesArgumentDefinitions, argumentSet.isCacheable {
+      self = argumentSetCache.insert(argumentSet, forKey: cacheKey)
+    } else {
+      self = argumentSet
+    }
+  }
+
+  /// A Boolean value indicating whether this argument set can be reused
+  /// across parses.
+  ///
+  /// The values of properties that aren't property wrappers are captured from
+  /// the instance that was reflected, so they need to be read again from a
+  /// new instance for each parse.
+  private var isCacheable: Bool {
+    !contains { arg in
+      if case .default = arg.kind { return true }
+      return false
+    }
+  }
+
+  /// Builds the argument set for `type` by reflecting over a new instance.
+  private static func reflecting(_ type: ParsableArguments.Type, creatingHelp: Bool) -> ArgumentSet {
     #if DEBUG
     do {
       try type._validate()
@@ -276,7 +387,7 @@ extension ArgumentSet {
           return ArgumentSet(definition)
         }
       }
-    self.init(sets: a)
+    return ArgumentSet(sets: a)
   }
 }
 
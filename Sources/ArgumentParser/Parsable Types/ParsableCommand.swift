@@ -31,10 +31,16 @@ public protocol ParsableCommand: ParsableArguments {
   mutating func run() throws
 }
 
+/// Command names derived from type names, which only need to be converted
+/// once per type.
+private let derivedCommandNames = SynchronizedCache<ObjectIdentifier, String>()
+
 extension ParsableCommand {
   public static var _commandName: String {
     configuration.commandName ??
-      String(describing: Self.self).convertedToSnakeCase(separator: "-")
+      derivedCommandNames.value(forKey: ObjectIdentifier(Self.self)) {
+        String(describing: Self.self).convertedToSnakeCase(separator: "-")
+      }
   }
   
   public static var configuration: CommandConfiguration {
@@ -59,8 +65,17 @@ extension ParsableCommand {
   public static func parseAsRoot(
     _ arguments: [String]? = nil
   ) throws -> ParsableCommand {
-    var parser = CommandParser(self)
     let arguments = arguments ?? Array(CommandLine.arguments.dropFirst())
+    
+    // Custom completion requests don't need the command tree, which is
+    // expensive to build for large commands.
+    do {
+      try CommandParser.handleCustomCompletion(arguments, rootCommand: self)
+    } catch let error as ParserError {
+      throw CommandError(commandStack: [self], parserError: error)
+    }
+    
+    var parser = CommandParser(self)
     return try parser.parse(arguments: arguments).get()
   }
   
@@ -80,7 +95,28 @@ extension ParsableCommand {
     columns: Int? = nil
   ) -> String { 
     let stack = CommandParser(self).commandStack(for: subcommand)
-    return HelpGenerator(commandStack: stack).rendered(screenWidth: columns)
+    return HelpGenerator.rendered(commandStack: stack, screenWidth: columns)
+  }
+
+  /// Writes the help screen for the given subcommand of this command to the
+  /// given output stream, section by section as it's rendered.
+  ///
+  /// - Parameters:
+  ///   - subcommand: The subcommand to write the help screen for.
+  ///     `subcommand` must be declared in the subcommand tree of this
+  ///     command.
+  ///   - output: The stream to write the help screen to.
+  ///   - columns: The column width to use when wrapping long lines in the
+  ///     help screen. If `columns` is `nil`, uses the current terminal
+  ///     width, or a default value of `80` if the terminal width is not
+  ///     available.
+  public static func writeHelpMessage<Target: TextOutputStream>(
+    for subcommand: ParsableCommand.Type,
+    to output: inout Target,
+    columns: Int? = nil
+  ) {
+    let stack = CommandParser(self).commandStack(for: subcommand)
+    HelpGenerator(commandStack: stack).render(screenWidth: columns, to: &output)
   }
 
   /// Parses an instance of this type, or one of its subcommands, from
@@ -92,12 +128,33 @@ extension ParsableCommand {
   public static func main(_ arguments: [String]?) {
     do {
       var command = try parseAsRoot(arguments)
+      try validateIsSynchronous(command)
       try command.run()
     } catch {
       exit(withError: error)
     }
   }
 
+  /// Throws an error if `command` needs the asynchronous `main()`, which
+  /// the synchronous `main()` can't provide.
+  ///
+  /// Without this check, an asynchronous command would run the synchronous
+  /// `run()` instead, which only prints its help.
+  static func validateIsSynchronous(_ command: ParsableCommand) throws {
+    #if compiler(>=5.6) && canImport(_Concurrency)
+    if #available(macOS 10.15, macCatalyst 13, iOS 13, tvOS 13, watchOS 6, *),
+      command is AsyncParsableCommand
+    {
+      let name = type(of: command)._commandName
+      throw ValidationError("""
+        '\(name)' is an asynchronous command, so it can only be run when \
+        '\(_commandName)' is an AsyncParsableCommand and its main() is \
+        called with 'await'.
+        """)
+    }
+    #endif
+  }
+
   /// Parses an instance of this type, or one of its subcommands, from
   /// command-line arguments and calls its `run()` method, exiting with a
   /// relevant error message if necessary.
@@ -0,0 +1,193 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+@_implementationOnly import Foundation
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#elseif canImport(CRT)
+import CRT
+#endif
+
+/// A source of values for a command's options and flags, besides the
+/// command line.
+///
+/// Add value sources to a command's configuration to read settings from the
+/// environment or from a configuration file:
+///
+///     struct Build: ParsableCommand {
+///         static var configuration = CommandConfiguration(
+///             valueSources: [
+///                 .environment(prefix: "BUILD_"),
+///                 .configurationFile(atPath: ".build-settings.json"),
+///             ])
+///
+///         @Option var jobs: Int = 4
+///         @Flag var verbose = false
+///     }
+///
+/// A value source is only consulted for an option or flag that wasn't given
+/// on the command line. Sources are checked in order, and the first one
+/// that has a value for an argument provides all of that argument's values.
+/// Each argument is looked up by its first `--`-prefixed name (or
+/// `-`-prefixed long name); positional arguments and arguments with only
+/// short names don't read from value sources.
+///
+/// Flags read a Boolean value: `true`, `yes`, `on`, or `1` has the same
+/// effect as the flag appearing on the command line, and `false`, `no`,
+/// `off`, or `0` has the same effect as the flag's inversion, such as
+/// `--no-color` for `color`, or no effect for a flag without one.
+public struct ValueSource {
+  /// Returns the values and a description of their location for the given
+  /// long name, or `nil` if this source doesn't have the name.
+  internal typealias Lookup = (String) throws -> (values: [String], location: String)?
+
+  /// Prepares this source for looking up the arguments of a single parse.
+  ///
+  /// A source that loads its values, such as a configuration file, does so
+  /// here, so that it's loaded once per parse rather than once per argument.
+  internal var resolve: () throws -> Lookup
+
+  /// A source that reads each argument from an environment variable.
+  ///
+  /// The variable's name is `prefix` followed by the argument's name in
+  /// uppercase, with dashes replaced by underscores. For example, with the
+  /// prefix `"BUILD_"`, the `--output-path` option reads from the variable
+  /// `BUILD_OUTPUT_PATH`. Each variable provides a single value.
+  public static func environment(prefix: String = "") -> ValueSource {
+    ValueSource {
+      { name in
+        let variable = prefix + name.uppercased().replacingOccurrences(of: "-", with: "_")
+        guard let value = getenv(variable) else { return nil }
+        return ([String(cString: value)], "environment variable \(variable)")
+      }
+    }
+  }
+
+  /// A source that reads arguments from the top-level keys of a
+  /// configuration file.
+  ///
+  /// Each key is an argument's name without its leading dashes, such as
+  /// `"output-path"`. The file is memory-mapped and parsed the first time
+  /// it's needed in a given format, and then kept for the rest of the
+  /// process. A missing file has no values, and is checked for again on the
+  /// next parse, but only once per parse; a file that can't be read or
+  /// parsed is an error.
+  ///
+  /// - Parameters:
+  ///   - path: The path to the configuration file.
+  ///   - format: The format of the file's contents.
+  public static func configurationFile(
+    atPath path: String,
+    format: ConfigurationFileFormat = .json
+  ) -> ValueSource {
+    ValueSource {
+      let values = try ConfigurationFile.values(atPath: path, format: format)
+      return { name in
+        guard let values = values[name] else { return nil }
+        return (values, "key '\(name)' in \(path)")
+      }
+    }
+  }
+}
+
+/// A format for the contents of a configuration file.
+///
+/// Supply your own format to read configuration files in formats other than
+/// JSON, such as TOML:
+///
+///     extension ConfigurationFileFormat {
+///         static let toml = ConfigurationFileFormat { contents in
+///             try TOMLTable(utf8: contents).stringValues()
+///         }
+///     }
+///
+/// A file's values are cached separately for each format instance, so store
+/// your format in a constant rather than creating it on each use.
+public struct ConfigurationFileFormat {
+  internal var read: (UnsafeRawBufferPointer) throws -> [String: [String]]
+
+  /// The identity of this format, which distinguishes a file's cached values
+  /// when it's read in different formats.
+  internal let identity = Identity()
+
+  internal final class Identity {}
+
+  /// Creates a format that reads a file's contents with the given closure.
+  ///
+  /// - Parameter read: A closure that receives the contents of a file and
+  ///   returns the values for each of the file's top-level keys, as the
+  ///   strings that would be passed on the command line. The contents are
+  ///   only valid for the duration of the call.
+  public init(read: @escaping (_ contents: UnsafeRawBufferPointer) throws -> [String: [String]]) {
+    self.read = read
+  }
+
+  /// A format for a JSON object whose values are strings, numbers,
+  /// Booleans, `null`, or arrays of those.
+  ///
+  /// Numbers use their text from the file, an array provides one value for
+  /// each element, and `null` is the same as a missing key.
+  public static let json = ConfigurationFileFormat { contents in
+    try JSONValueReader(contents).readTopLevelObject()
+  }
+}
+
+/// The values of configuration files that have already been read, keyed by
+/// path and format.
+private let configurationFileCache = SynchronizedCache<ConfigurationFile.Key, ConfigurationFile.Entry>()
+
+enum ConfigurationFile {
+  struct Key: Hashable {
+    var path: String
+    var format: ObjectIdentifier
+  }
+
+  struct Entry {
+    /// The format that read `values`, which keeps its identifier in the
+    /// cache's key from being reused by another format.
+    var format: ConfigurationFileFormat.Identity
+    var values: [String: [String]]
+  }
+
+  /// Returns the values in the file at `path`, reading it on first use in
+  /// `format`.
+  ///
+  /// Only files that were read successfully are cached, so a missing file
+  /// or an error is checked for again on the next parse.
+  static func values(atPath path: String, format: ConfigurationFileFormat) throws -> [String: [String]] {
+    let key = Key(path: path, format: ObjectIdentifier(format.identity))
+    if let cached = configurationFileCache[key] {
+      return cached.values
+    }
+    guard let values = try read(atPath: path, format: format) else { return [:] }
+    return configurationFileCache.insert(Entry(format: format.identity, values: values), forKey: key).values
+  }
+
+  /// Reads the file at `path`, or returns `nil` if there's no such file.
+  private static func read(atPath path: String, format: ConfigurationFileFormat) throws -> [String: [String]]? {
+    guard FileManager.default.fileExists(atPath: path) else { return nil }
+
+    do {
+      let contents = try Data(contentsOf: URL(fileURLWithPath: path), options: .alwaysMapped)
+      return try contents.withUnsafeBytes { try format.read($0) }
+    } catch {
+      throw ValidationError("Couldn't read configuration file '\(path)': \(error)")
+    }
+  }
+
+  /// Removes every cached file, so that the next parse reads them again.
+  static func removeCachedFiles() {
+    configurationFileCache.removeAll()
+  }
+}
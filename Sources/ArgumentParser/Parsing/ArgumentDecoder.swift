@@ -45,6 +45,10 @@ final class ArgumentDecoder: Decoder {
   var nextCommandIndex = 0
   var previouslyDecoded: [DecodedArguments] = []
   
+  /// The commands being parsed, from the root command to the one being
+  /// decoded, for reporting errors that are found after parsing.
+  var commandStack: [ParsableCommand.Type] = []
+  
   var codingPath: [CodingKey] = []
   
   var userInfo: [CodingUserInfoKey : Any] = [:]
@@ -108,7 +112,7 @@ final class ParsedArgumentsContainer<K>: KeyedDecodingContainerProtocol where K
   }
   
   func decode<T>(_ type: T.Type, forKey key: K) throws -> T where T : Decodable {
-    let subDecoder = SingleValueDecoder(userInfo: decoder.userInfo, underlying: decoder, codingPath: codingPath + [key], key: InputKey(key), parsedElement: element(forKey: key))
+    let subDecoder = SingleValueDecoder(userInfo: decoder.userInfo, underlying: decoder, parentCodingPath: codingPath, codingKey: key, key: InputKey(key), parsedElement: element(forKey: key))
     return try type.init(from: subDecoder)
   }
   
@@ -117,7 +121,7 @@ final class ParsedArgumentsContainer<K>: KeyedDecodingContainerProtocol where K
     if let parsedElement = parsedElement, parsedElement.inputOrigin.isDefaultValue {
       return parsedElement.value as? T
     }
-    let subDecoder = SingleValueDecoder(userInfo: decoder.userInfo, underlying: decoder, codingPath: codingPath + [key], key: InputKey(key), parsedElement: parsedElement)
+    let subDecoder = SingleValueDecoder(userInfo: decoder.userInfo, underlying: decoder, parentCodingPath: codingPath, codingKey: key, key: InputKey(key), parsedElement: parsedElement)
     do {
       return try type.init(from: subDecoder)
     } catch let error as ParserError {
@@ -149,26 +153,35 @@ final class ParsedArgumentsContainer<K>: KeyedDecodingContainerProtocol where K
 struct SingleValueDecoder: Decoder {
   var userInfo: [CodingUserInfoKey : Any]
   var underlying: ArgumentDecoder
-  var codingPath: [CodingKey]
+  var parentCodingPath: [CodingKey]
+  var codingKey: CodingKey
   var key: InputKey
   var parsedElement: ParsedValues.Element?
   
+  /// The coding path of this decoder.
+  ///
+  /// This is only built when requested, since most values are decoded
+  /// without ever looking at their coding path.
+  var codingPath: [CodingKey] {
+    parentCodingPath + [codingKey]
+  }
+  
   func container<K>(keyedBy type: K.Type) throws -> KeyedDecodingContainer<K> where K: CodingKey {
     return KeyedDecodingContainer(ParsedArgumentsContainer(for: underlying, keyType: type, codingPath: codingPath))
   }
   
   func unkeyedContainer() throws -> UnkeyedDecodingContainer {
     guard let e = parsedElement else {
-      throw ParserError.noValue(forKey: InputKey(rawValue: codingPath.last!.stringValue))
+      throw ParserError.noValue(forKey: key)
     }
     guard let a = e.value as? [Any] else {
       throw ParserError.invalidState
     }
-    return UnkeyedContainer(codingPath: codingPath, parsedElement: e, array: ArrayWrapper(a))
+    return UnkeyedContainer(underlying: self, parsedElement: e, array: ArrayWrapper(a))
   }
   
   func singleValueContainer() throws -> SingleValueDecodingContainer {
-    return SingleValueContainer(underlying: self, codingPath: codingPath, parsedElement: parsedElement)
+    return SingleValueContainer(underlying: self, parsedElement: parsedElement)
   }
   
   func previousValue<T>(_ type: T.Type) throws -> T {
@@ -183,16 +196,19 @@ struct SingleValueDecoder: Decoder {
   
   struct SingleValueContainer: SingleValueDecodingContainer {
     var underlying: SingleValueDecoder
-    var codingPath: [CodingKey]
     var parsedElement: ParsedValues.Element?
     
+    var codingPath: [CodingKey] {
+      underlying.codingPath
+    }
+    
     func decodeNil() -> Bool {
       return parsedElement == nil
     }
     
     func decode<T>(_ type: T.Type) throws -> T where T : Decodable {
       guard let e = parsedElement else {
-        throw ParserError.noValue(forKey: InputKey(rawValue: codingPath.last!.stringValue))
+        throw ParserError.noValue(forKey: underlying.key)
       }
       guard let s = e.value as? T else {
         throw InternalParseError.wrongType(e.value, forKey: e.key)
@@ -202,10 +218,14 @@ struct SingleValueDecoder: Decoder {
   }
   
   struct UnkeyedContainer: UnkeyedDecodingContainer {
-    var codingPath: [CodingKey]
+    var underlying: SingleValueDecoder
     var parsedElement: ParsedValues.Element
     var array: ArrayWrapperProtocol
     
+    var codingPath: [CodingKey] {
+      underlying.codingPath
+    }
+    
     var count: Int? {
       return array.count
     }
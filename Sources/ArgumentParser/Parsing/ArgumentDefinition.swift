@@ -24,6 +24,7 @@ struct ArgumentDefinition {
   }
   
   typealias Initial = (InputOrigin, inout ParsedValues) throws -> Void
+  typealias Finalize = (inout ParsedValues) throws -> Void
   
   enum Kind {
     /// An option or flag, with a name and an optional value.
@@ -39,47 +40,101 @@ struct ArgumentDefinition {
   
   struct Help {
     var options: Options
+    var keys: [InputKey]
+
+    /// The text and other details that are only needed for help, usage,
+    /// error messages, and completions, shared by copies of this help until
+    /// one of them is modified.
+    private var details: Details
 
     // `ArgumentHelp` members
-    var abstract: String = ""
-    var discussion: String = ""
-    var valueName: String = ""
-    var shouldDisplay: Bool = true
+    var abstract: String {
+      get { details.abstract }
+      set { updateDetails { $0.abstract = newValue } }
+    }
+    var discussion: String {
+      get { details.discussion }
+      set { updateDetails { $0.discussion = newValue } }
+    }
+    var valueName: String {
+      get { details.valueName }
+      set { updateDetails { $0.valueName = newValue } }
+    }
+    var shouldDisplay: Bool {
+      get { details.shouldDisplay }
+      set { updateDetails { $0.shouldDisplay = newValue } }
+    }
 
-    var defaultValue: String?
-    var keys: [InputKey]
-    var allValues: [String] = []
-    var isComposite: Bool = false
+    var defaultValue: String? {
+      get { details.defaultValue }
+      set { updateDetails { $0.defaultValue = newValue } }
+    }
+    var isComposite: Bool {
+      get { details.isComposite }
+      set { updateDetails { $0.isComposite = newValue } }
+    }
+    var completion: CompletionKind {
+      get { details.completion }
+      set { updateDetails { $0.completion = newValue } }
+    }
     
     struct Options: OptionSet {
       var rawValue: UInt
       
       static let isOptional = Options(rawValue: 1 << 0)
       static let isRepeating = Options(rawValue: 1 << 1)
+      /// The argument is one half of an inverted flag, whose other half is
+      /// the other definition with the same key and this option.
+      static let isInvertible = Options(rawValue: 1 << 2)
     }
     
-    init(options: Options = [], help: ArgumentHelp? = nil, defaultValue: String? = nil, key: InputKey, isComposite: Bool = false) {
-      self.options = options
-      self.defaultValue = defaultValue
-      self.keys = [key]
-      self.isComposite = isComposite
-      updateArgumentHelp(help: help)
+    private final class Details {
+      var abstract: String = ""
+      var discussion: String = ""
+      var valueName: String = ""
+      var shouldDisplay: Bool = true
+      var defaultValue: String?
+      var isComposite: Bool = false
+      var completion: CompletionKind = .default
+
+      init() {}
+
+      func copy() -> Details {
+        let result = Details()
+        result.abstract = abstract
+        result.discussion = discussion
+        result.valueName = valueName
+        result.shouldDisplay = shouldDisplay
+        result.defaultValue = defaultValue
+        result.isComposite = isComposite
+        result.completion = completion
+        return result
+      }
     }
     
-    init<T: ExpressibleByArgument>(type: T.Type, options: Options = [], help: ArgumentHelp? = nil, defaultValue: String? = nil, key: InputKey) {
+    init(options: Options = [], help: ArgumentHelp? = nil, defaultValue: String? = nil, key: InputKey, isComposite: Bool = false) {
       self.options = options
-
-      self.defaultValue = defaultValue
       self.keys = [key]
-      self.allValues = type.allValueStrings
+      self.details = Details()
+      details.defaultValue = defaultValue
+      details.isComposite = isComposite
       updateArgumentHelp(help: help)
     }
 
     mutating func updateArgumentHelp(help: ArgumentHelp?) {
-      self.abstract = help?.abstract ?? ""
-      self.discussion = help?.discussion ?? ""
-      self.valueName = help?.valueName ?? ""
-      self.shouldDisplay = help?.shouldDisplay ?? true
+      updateDetails {
+        $0.abstract = help?.abstract ?? ""
+        $0.discussion = help?.discussion ?? ""
+        $0.valueName = help?.valueName ?? ""
+        $0.shouldDisplay = help?.shouldDisplay ?? true
+      }
+    }
+
+    private mutating func updateDetails(_ update: (Details) -> Void) {
+      if !isKnownUniquelyReferenced(&details) {
+        details = details.copy()
+      }
+      update(details)
     }
   }
   
@@ -101,11 +156,19 @@ struct ArgumentDefinition {
   
   var kind: Kind
   var help: Help
-  var completion: CompletionKind
   var parsingStrategy: ParsingStrategy
   var update: Update
   var initial: Initial
   
+  /// A closure that runs after all of the input for this argument's
+  /// command has been parsed, if any.
+  var finalize: Finalize? = nil
+  
+  var completion: CompletionKind {
+    get { help.completion }
+    set { help.completion = newValue }
+  }
+  
   var names: [Name] {
     switch kind {
     case .named(let n): return n
@@ -135,7 +198,13 @@ struct ArgumentDefinition {
     
     self.kind = kind
     self.help = help
-    self.completion = completion
+    
+    // The caller usually still holds `help`, so only store a completion kind
+    // that differs from the default, to avoid copying the help details.
+    switch completion.kind {
+    case .default: break
+    default: self.help.completion = completion
+    }
     self.parsingStrategy = parsingStrategy
     self.update = update
     self.initial = initial
@@ -20,13 +20,12 @@
 /// another. Both of these can then be combined into a third set.
 struct ArgumentSet {
   var content: [ArgumentDefinition] = []
-  var namePositions: [Name: Int] = [:]
+  var namePositions = NameIndex()
   
   init<S: Sequence>(_ arguments: S) where S.Element == ArgumentDefinition {
     self.content = Array(arguments)
-    self.namePositions = Dictionary(
-      content.enumerated().flatMap { i, arg in arg.names.map { ($0.nameToMatch, i) } },
-      uniquingKeysWith: { first, _ in first })
+    self.namePositions = NameIndex(
+      content.enumerated().lazy.flatMap { i, arg in arg.names.lazy.map { ($0, i) } })
   }
   
   init() {}
@@ -42,8 +41,8 @@ struct ArgumentSet {
   mutating func append(_ arg: ArgumentDefinition) {
     let newPosition = content.count
     content.append(arg)
-    for name in arg.names where namePositions[name.nameToMatch] == nil {
-      namePositions[name.nameToMatch] = newPosition
+    for name in arg.names {
+      namePositions.insert(name, at: newPosition)
     }
   }
 }
@@ -84,7 +83,16 @@ extension ArgumentSet {
     return ArgumentSet(arg)
   }
 
-  static func updateFlag<Value: Equatable>(key: InputKey, value: Value, origin: InputOrigin, values: inout ParsedValues, hasUpdated: Bool, exclusivity: FlagExclusivity) throws -> Bool {
+  /// Updates the value for a flag that shares `key` with other flags,
+  /// honoring `exclusivity`.
+  ///
+  /// Whether one of the flags has already been seen is derived from the
+  /// parsed values themselves, rather than from state captured by the update
+  /// closures, so that argument definitions can be shared between parses.
+  static func updateFlag<Value: Equatable>(key: InputKey, value: Value, origin: InputOrigin, values: inout ParsedValues, exclusivity: FlagExclusivity) throws {
+    // Initial values are set with an empty input origin, so any recorded
+    // origin means one of these flags was encountered.
+    let hasUpdated = values.element(forKey: key).map { !$0.inputOrigin.isEmpty } ?? false
     switch (hasUpdated, exclusivity.base) {
     case (true, .exclusive):
       // This value has already been set.
@@ -102,29 +110,27 @@ extension ArgumentSet {
     case (false, _), (_, .chooseLast):
       values.set(value, forKey: key, inputOrigin: origin)
     }
-    return true
   }
   
   /// Creates an argument set for a pair of inverted Boolean flags.
   static func flag(key: InputKey, name: NameSpecification, default initialValue: Bool?, inversion: FlagInversion, exclusivity: FlagExclusivity, help: ArgumentHelp?) -> ArgumentSet {
     // The flag is required if initialValue is `nil`, otherwise it's optional
-    let helpOptions: ArgumentDefinition.Help.Options = initialValue != nil ? .isOptional : []
+    let helpOptions: ArgumentDefinition.Help.Options = initialValue != nil ? [.isOptional, .isInvertible] : .isInvertible
     
     let enableHelp = ArgumentDefinition.Help(options: helpOptions, help: help, defaultValue: initialValue.map(String.init), key: key, isComposite: true)
-    let disableHelp = ArgumentDefinition.Help(options: [.isOptional], help: help, key: key)
+    let disableHelp = ArgumentDefinition.Help(options: [.isOptional, .isInvertible], help: help, key: key)
 
     let (enableNames, disableNames) = inversion.enableDisableNamePair(for: key, name: name)
 
-    var hasUpdated = false
     let enableArg = ArgumentDefinition(kind: .named(enableNames), help: enableHelp, completion: .default, update: .nullary({ (origin, name, values) in
-        hasUpdated = try ArgumentSet.updateFlag(key: key, value: true, origin: origin, values: &values, hasUpdated: hasUpdated, exclusivity: exclusivity)
+        try ArgumentSet.updateFlag(key: key, value: true, origin: origin, values: &values, exclusivity: exclusivity)
     }), initial: { origin, values in
       if let initialValue = initialValue {
         values.set(initialValue, forKey: key, inputOrigin: origin)
       }
     })
     let disableArg = ArgumentDefinition(kind: .named(disableNames), help: disableHelp, completion: .default, update: .nullary({ (origin, name, values) in
-        hasUpdated = try ArgumentSet.updateFlag(key: key, value: false, origin: origin, values: &values, hasUpdated: hasUpdated, exclusivity: exclusivity)
+        try ArgumentSet.updateFlag(key: key, value: false, origin: origin, values: &values, exclusivity: exclusivity)
     }), initial: { _, _ in })
     return ArgumentSet([enableArg, disableArg])
   }
@@ -192,8 +198,9 @@ extension ArgumentSet {
   /// the matching command(s).
   ///
   /// - Parameter all: The input (from the command line) that needs to be parsed
-  /// - Parameter commandStack: commands that have been parsed
-  func lenientParse(_ all: SplitArguments) throws -> ParsedValues {
+  /// - Parameter allowingAbbreviations: Whether options can be abbreviated
+  ///   to an unambiguous prefix of their long name.
+  func lenientParse(_ all: SplitArguments, allowingAbbreviations: Bool = false, valueSources: [ValueSource] = []) throws -> ParsedValues {
     // Create a local, mutable copy of the arguments:
     var inputArguments = all
     
@@ -354,14 +361,14 @@ extension ArgumentSet {
         // input. If we can't find one, just move on to the next input. We
         // defer catching leftover arguments until we've fully extracted all
         // the information for the selected command.
-        guard let argument = first(matching: parsed) else
+        guard let argument = first(matching: parsed, allowingAbbreviations: allowingAbbreviations) else
         {
           // If we're capturing all, an unrecognized option/flag is the start
           // of positional input. However, the first time we see an option
           // pack (like `-fi`) it looks like a long name with a single-dash
           // prefix, which may not match an argument even if its subcomponents
           // will match.
-          if capturesAll && parsed.subarguments.isEmpty { break ArgumentLoop }
+          if capturesAll && !parsed.isShortOptionPack { break ArgumentLoop }
           
           // Otherwise, continue parsing. This option/flag may get picked up
           // by a child command.
@@ -390,6 +397,14 @@ extension ArgumentSet {
     var unusedArguments = all
     unusedArguments.removeAll(in: allUsedOrigins)
     try parsePositionalValues(from: unusedArguments, into: &result)
+    
+    if !valueSources.isEmpty {
+      try setValues(from: valueSources, into: &result)
+    }
+    
+    for argument in self {
+      try argument.finalize?(&result)
+    }
 
     return result
   }
@@ -403,6 +418,76 @@ extension ArgumentSet {
       try arg.initial(InputOrigin(), &parsed)
     }
   }
+  
+  /// Fills the given `ParsedValues` instance with values from `sources`,
+  /// for the named arguments that weren't given on the command line.
+  func setValues(from sources: [ValueSource], into parsed: inout ParsedValues) throws {
+    // Each source is resolved when the first argument needs it, and then
+    // reused for the rest of the arguments.
+    var lookups: [ValueSource.Lookup]?
+    for argument in self {
+      guard let name = argument.names.first(where: { $0.case != .short }) else { continue }
+      let key = argument.help.keys[0]
+      
+      // Values on the command line, including ones for other arguments with
+      // the same key, such as an inverted flag, take precedence.
+      guard !argument.help.keys.contains(where: {
+        parsed.element(forKey: $0)?.inputOrigin.includesArgumentIndex ?? false
+      }) else { continue }
+      
+      var found: (values: [String], location: String)?
+      do {
+        if lookups == nil {
+          lookups = try sources.map { try $0.resolve() }
+        }
+        for lookup in lookups! {
+          found = try lookup(name.valueString)
+          if found != nil { break }
+        }
+      } catch {
+        throw ParserError.userValidationError(error)
+      }
+      guard let (values, location) = found else { continue }
+      
+      let origin = InputOrigin(element: .valueSource(location))
+      for value in values {
+        switch argument.update {
+        case let .unary(update):
+          try update(origin, name, value, &parsed)
+        case let .nullary(update):
+          switch value.lowercased() {
+          case "true", "yes", "on", "1":
+            try update(origin, name, &parsed)
+          case "false", "no", "off", "0":
+            // A false value has the same effect as the flag's inversion, if
+            // it has one, and otherwise no effect.
+            if let (inverse, inverseName) = self.inverse(of: argument),
+               case let .nullary(inverseUpdate) = inverse.update
+            {
+              try inverseUpdate(origin, inverseName, &parsed)
+            }
+          default:
+            throw ParserError.unableToParseValue(origin, name, value, forKey: key)
+          }
+        }
+      }
+    }
+  }
+  
+  /// Returns the other half of the inverted flag that `argument` belongs to,
+  /// along with the name to report when applying it, if there is one.
+  private func inverse(of argument: ArgumentDefinition) -> (ArgumentDefinition, Name)? {
+    guard argument.help.options.contains(.isInvertible) else { return nil }
+    for other in self where other.help.options.contains(.isInvertible)
+      && other.help.keys == argument.help.keys
+      && other.names != argument.names
+    {
+      guard let name = other.names.first(where: { $0.case != .short }) ?? other.names.first
+        else { continue }
+      return (other, name)
+    }
+    return nil
+  }
 }
 
 extension ArgumentSet {
@@ -412,12 +497,20 @@ extension ArgumentSet {
   /// definition that matches the particular element.
   /// - Parameters:
   ///   - parsed: The argument from the command line
-  ///   - origin: Where `parsed` came from.
+  ///   - allowingAbbreviations: Whether a `--`-prefixed name can match the
+  ///     only argument with a long name that starts with it.
   /// - Returns: The matching definition.
   func first(
-    matching parsed: ParsedArgument
+    matching parsed: ParsedArgument,
+    allowingAbbreviations: Bool = false
   ) -> ArgumentDefinition? {
-    namePositions[parsed.name].map { content[$0] }
+    if let position = namePositions.position(of: parsed.name) {
+      return content[position]
+    }
+    guard allowingAbbreviations, case .long(let prefix) = parsed.name else {
+      return nil
+    }
+    return namePositions.position(ofLongNameWithPrefix: prefix).map { content[$0] }
   }
   
   func firstPositional(
@@ -21,6 +21,13 @@ struct CommandParser {
   var currentNode: Tree<ParsableCommand.Type>
   var decodedArguments: [DecodedArguments] = []
   
+  /// Whether `parse(arguments:)` answers the hidden `---completion` requests
+  /// that generated completion scripts make.
+  ///
+  /// Only a command's own `main()` or `parseAsRoot(_:)` should answer these;
+  /// a `CommandLineParser` treats them as invalid options instead.
+  var handlesCompletionRequests = true
+  
   var rootCommand: ParsableCommand.Type {
     commandTree.element
   }
@@ -35,19 +42,39 @@ struct CommandParser {
   }
   
   init(_ rootCommand: ParsableCommand.Type) {
-    do {
-      self.commandTree = try Tree(root: rootCommand)
-    } catch Tree<ParsableCommand.Type>.InitializationError.recursiveSubcommand(let command) {
-      fatalError("The ParsableCommand \"\(command)\" can't have itself as its own subcommand.")
-    } catch {
-      fatalError("Unexpected error: \(error).")
-    }
+    self.init(commandTree: CommandParser.commandTree(for: rootCommand))
+  }
+  
+  init(commandTree: Tree<ParsableCommand.Type>) {
+    self.commandTree = commandTree
     self.currentNode = commandTree
-    
-    // A command tree that has a depth greater than zero gets a `help`
-    // subcommand.
-    if !commandTree.isLeaf {
-      commandTree.addChild(Tree(HelpCommand.self))
+  }
+}
+
+/// Command trees that have already been built, keyed by their root command.
+///
+/// A command tree isn't modified after it's built, except to expand its lazily
+/// built nodes, which is synchronized, so a single tree can be shared by every
+/// parser for the same root command. Building the tree lazily is what helps a
+/// process's first parse; the cache helps the parses after it.
+private let commandTreeCache = SynchronizedCache<ObjectIdentifier, Tree<ParsableCommand.Type>>()
+
+extension CommandParser {
+  /// Returns the command tree for `rootCommand`, building it the first time
+  /// it's requested.
+  static func commandTree(for rootCommand: ParsableCommand.Type) -> Tree<ParsableCommand.Type> {
+    commandTreeCache.value(forKey: ObjectIdentifier(rootCommand)) {
+      traced(.commandTree, command: rootCommand._commandName, if: !(rootCommand is PseudoCommand.Type)) {
+        let commandTree = Tree.lazilyBuilt(root: rootCommand)
+        
+        // A command tree that has a depth greater than zero gets a `help`
+        // subcommand. This builds the root's children, but not any deeper
+        // nodes.
+        if !commandTree.isLeaf {
+          commandTree.addSubcommand(Tree(HelpCommand.self))
+        }
+        return commandTree
+      }
     }
   }
 }
@@ -83,6 +110,9 @@ extension CommandParser {
     guard !split.contains(Name.long("dump-help")) else {
       throw CommandError(commandStack: commandStack, parserError: .dumpHelpRequested)
     }
+    guard !split.contains(Name.long("dump-help-compact")) else {
+      throw CommandError(commandStack: commandStack, parserError: .compactDumpHelpRequested)
+    }
 
     // Look for --version if any commands in the stack define a version
     if commandStack.contains(where: { !$0.configuration.version.isEmpty }) {
@@ -109,6 +139,24 @@ extension CommandParser {
       }
        
       let extra = split.coalescedExtraElements()
+      
+      // If this command has subcommands, the first extra value may be a
+      // misspelled subcommand name. Subcommand names can be very short, so
+      // the allowed distance also depends on the length of the value.
+      if !currentNode.isLeaf, let (origin, value) = extra.first {
+        let subcommandNames = currentNode.children.lazy
+          .filter { $0.element.configuration.shouldDisplay }
+          .map { $0.element._commandName }
+        let maximumDistance = min(
+          ErrorMessageGenerator.maximumSuggestionDistance,
+          value.count / 2)
+        if let suggestion = value.closestMatch(
+          in: subcommandNames, maximumDistance: maximumDistance)
+        {
+          throw ParserError.unknownSubcommand(origin, value, suggestion: suggestion)
+        }
+      }
+      
       throw ParserError.unexpectedExtraValues(extra)
     }
     
@@ -119,6 +167,14 @@ extension CommandParser {
     return lastCommand
   }
   
+  /// The value sources for the current command, which are inherited from
+  /// the nearest ancestor that has any.
+  fileprivate var currentValueSources: [ValueSource] {
+    commandStack.reversed().lazy
+      .map { $0.configuration.valueSources }
+      .first(where: { !$0.isEmpty }) ?? []
+  }
+  
   /// Extracts the current command from `split`, throwing if decoding isn't
   /// possible.
   fileprivate mutating func parseCurrent(_ split: inout SplitArguments) throws -> ParsableCommand {
@@ -126,13 +182,21 @@ extension CommandParser {
     let commandArguments = ArgumentSet(currentNode.element)
     
     // Parse the arguments, ignoring anything unexpected
-    let values = try commandArguments.lenientParse(split)
+    let values = try traced(.parse, command: commandStack.traceName, if: isTraced) {
+      try commandArguments.lenientParse(
+        split,
+        allowingAbbreviations: currentNode.element.configuration.allowsAbbreviatedNames,
+        valueSources: currentValueSources)
+    }
     
     // Decode the values from ParsedValues into the ParsableCommand:
     let decoder = ArgumentDecoder(values: values, previouslyDecoded: decodedArguments)
+    decoder.commandStack = commandStack
     var decodedResult: ParsableCommand
     do {
-      decodedResult = try currentNode.element.init(from: decoder)
+      decodedResult = try traced(.decode, command: commandStack.traceName, if: isTraced) {
+        try currentNode.element.init(from: decoder)
+      }
     } catch let error {
       // If decoding this command failed, see if they were asking for
       // help before propagating that parsing failure.
@@ -161,7 +225,9 @@ extension CommandParser {
 
       // after decoding a command, make sure to validate it
       do {
-        try parsedCommand.validate()
+        try traced(.validate, command: commandStack.traceName) {
+          try parsedCommand.validate()
+        }
         var lastArgument = decodedArguments.removeLast()
         lastArgument.value = parsedCommand
         decodedArguments.append(lastArgument)
@@ -199,15 +265,22 @@ extension CommandParser {
   /// - Parameter arguments: The array of arguments to parse. This should not
   ///   include the command name as the first argument.
   mutating func parse(arguments: [String]) -> Result<ParsableCommand, CommandError> {
-    do {
-      try handleCustomCompletion(arguments)
-    } catch {
-      return .failure(CommandError(commandStack: [commandTree.element], parserError: error as! ParserError))
+    if handlesCompletionRequests {
+      do {
+        try handleCustomCompletion(arguments)
+      } catch {
+        return .failure(CommandError(commandStack: [commandTree.element], parserError: error as! ParserError))
+      }
     }
     
     var split: SplitArguments
     do {
-      split = try SplitArguments(arguments: arguments)
+      split = try traced(.splitArguments, command: commandTree.element._commandName) {
+        let expandedArguments = try rootCommand.configuration.allowsResponseFiles
+          ? ResponseFileExpander.expand(arguments)
+          : arguments
+        return try SplitArguments(arguments: expandedArguments)
+      }
     } catch let error as ParserError {
       return .failure(CommandError(commandStack: [commandTree.element], parserError: error))
     } catch {
@@ -241,14 +314,39 @@ extension CommandParser {
 
 // MARK: Completion Script Support
 
-struct GenerateCompletions: ParsableCommand {
+/// A command that the parser uses internally to look for built-in options,
+/// such as `--generate-completion-script`, and that isn't reported to the
+/// parse tracer.
+protocol PseudoCommand: ParsableCommand {}
+
+extension PseudoCommand {
+  static var cachesArgumentDefinitions: Bool { true }
+}
+
+extension CommandParser {
+  /// Whether this parser reports the phases of parsing its current command
+  /// to the parse tracer.
+  fileprivate var isTraced: Bool {
+    !(currentNode.element is PseudoCommand.Type)
+  }
+}
+
+struct GenerateCompletions: PseudoCommand {
   @Option() var generateCompletionScript: String
 }
 
-struct AutodetectedGenerateCompletions: ParsableCommand {
+struct AutodetectedGenerateCompletions: PseudoCommand {
   @Flag() var generateCompletionScript = false
 }
 
+struct GenerateCompletionShim: PseudoCommand {
+  @Option() var generateCompletionShim: String
+}
+
+struct AutodetectedGenerateCompletionShim: PseudoCommand {
+  @Flag() var generateCompletionShim = false
+}
+
 extension CommandParser {
   func checkForCompletionScriptRequest(_ split: inout SplitArguments) throws {
     // Pseudo-commands don't support `--generate-completion-script` flag
@@ -272,9 +370,90 @@ extension CommandParser {
     {
       throw CommandError(commandStack: commandStack, parserError: .completionScriptRequested(shell: nil))
     }
+    
+    // Then the same two forms of `--generate-completion-shim`
+    var shimParser = CommandParser(GenerateCompletionShim.self)
+    if let result = try? shimParser.parseCurrent(&split) as? GenerateCompletionShim {
+      throw CommandError(commandStack: commandStack, parserError: .completionShimRequested(shell: result.generateCompletionShim))
+    }
+    
+    var autodetectedShimParser = CommandParser(AutodetectedGenerateCompletionShim.self)
+    if let result = try? autodetectedShimParser.parseCurrent(&split) as? AutodetectedGenerateCompletionShim,
+       result.generateCompletionShim
+    {
+      throw CommandError(commandStack: commandStack, parserError: .completionShimRequested(shell: nil))
+    }
   }
     
   func handleCustomCompletion(_ arguments: [String]) throws {
+    try CommandParser.handleCustomCompletion(arguments, rootCommand: rootCommand)
+  }
+  
+  /// Calls the custom completion function that `arguments` requests, if
+  /// `arguments` is a `---completion` request, and throws its output.
+  ///
+  /// A `---completion-server` request instead answers completion requests
+  /// from standard input until it's closed, and a `---completion-function`
+  /// request prints the completion functions for a single subcommand.
+  static func handleCustomCompletion(_ arguments: [String], rootCommand: ParsableCommand.Type) throws {
+    if arguments.first == "---completion-server" {
+      CompletionServer(rootCommand: rootCommand).serveStandardInput()
+      throw ParserError.completionScriptCustomResponse("")
+    }
+    
+    if let functions = try completionFunctions(for: arguments, rootCommand: rootCommand) {
+      throw ParserError.completionScriptCustomResponse(functions)
+    }
+    
+    if let completions = try customCompletions(for: arguments, rootCommand: rootCommand) {
+      // Parsing and retrieval successful! We don't want to continue with any
+      // other parsing here, so after printing the result of the completion
+      // function, exit with a success code.
+      throw ParserError.completionScriptCustomResponse(completions.joined(separator: "\n"))
+    }
+  }
+  
+  /// Returns the completion functions that `arguments` requests, or `nil` if
+  /// `arguments` isn't a `---completion-function` request.
+  ///
+  /// Completion scripts that load subcommand completions lazily make this
+  /// request the first time a subcommand's completions are needed.
+  static func completionFunctions(for arguments: [String], rootCommand: ParsableCommand.Type) throws -> String? {
+    // <command> ---completion-function <shell> [<subcommand> ...]
+    guard arguments.first == "---completion-function"
+      else { return nil }
+    
+    var args = arguments.dropFirst()
+    guard let shell = args.popFirst().flatMap(CompletionShell.init(rawValue:))
+      else { throw ParserError.invalidState }
+    
+    var commands = [rootCommand]
+    for subcommandName in args {
+      guard let nextCommand = commands.last!.configuration.subcommands
+              .first(where: { $0._commandName == subcommandName })
+        else { throw ParserError.invalidState }
+      commands.append(nextCommand)
+    }
+    guard commands.count > 1 else { throw ParserError.invalidState }
+    
+    switch shell {
+    case .bash:
+      return BashCompletionsGenerator.generateLazyCompletionFunction(commands)
+    case .zsh:
+      return ZshCompletionsGenerator.generateLazyCompletionFunction(commands)
+    default:
+      throw ParserError.invalidState
+    }
+  }
+  
+  /// Returns the result of the custom completion function that `arguments`
+  /// requests, or `nil` if `arguments` isn't a `---completion` request.
+  ///
+  /// This runs on every keystroke that asks for custom completions, so it
+  /// doesn't need a command tree: it follows the requested subcommands
+  /// through each command's configuration, and only builds the argument set
+  /// for the last one.
+  static func customCompletions(for arguments: [String], rootCommand: ParsableCommand.Type) throws -> [String]? {
     // Completion functions use a custom format:
     //
     // <command> ---completion [<subcommand> ...] -- <argument-name> [<completion-text>]
@@ -282,17 +461,18 @@ extension CommandParser {
     // The triple-dash prefix makes '---completion' invalid syntax for regular
     // arguments, so it's safe to use for this internal purpose.
     guard arguments.first == "---completion"
-      else { return }
+      else { return nil }
     
     var args = arguments.dropFirst()
-    var current = commandTree
+    var current = rootCommand
     while let subcommandName = args.popFirst() {
       // A double dash separates the subcommands from the argument information
       if subcommandName == "--" { break }
       
-      guard let nextCommandNode = current.firstChild(withName: subcommandName)
+      guard let nextCommand = current.configuration.subcommands
+              .first(where: { $0._commandName == subcommandName })
         else { throw ParserError.invalidState }
-      current = nextCommandNode
+      current = nextCommand
     }
     
     // Some kind of argument name is the next required element
@@ -303,34 +483,30 @@ extension CommandParser {
     let completionValues = Array(args)
 
     // Generate the argument set and parse the argument to find in the set
-    let argset = ArgumentSet(current.element)
+    let argset = ArgumentSet(current)
     let parsedArgument = try! parseIndividualArg(argToMatch, at: 0).first!
     
     // Look up the specified argument and retrieve its custom completion function
-    let completionFunction: ([String]) -> [String]
+    let matchedArgument: ArgumentDefinition?
     
     switch parsedArgument.value {
     case .option(let parsed):
-      guard let matchedArgument = argset.first(matching: parsed),
-        case .custom(let f) = matchedArgument.completion.kind
-        else { throw ParserError.invalidState }
-      completionFunction = f
+      matchedArgument = argset.first(matching: parsed)
 
     case .value(let str):
-      guard let matchedArgument = argset.firstPositional(named: str),
-        case .custom(let f) = matchedArgument.completion.kind
-        else { throw ParserError.invalidState }
-      completionFunction = f
+      matchedArgument = argset.firstPositional(named: str)
       
     case .terminator:
       throw ParserError.invalidState
     }
     
-    // Parsing and retrieval successful! We don't want to continue with any
-    // other parsing here, so after printing the result of the completion
-    // function, exit with a success code.
-    let output = completionFunction(completionValues).joined(separator: "\n")
-    throw ParserError.completionScriptCustomResponse(output)
+    guard let argument = matchedArgument,
+      case .custom(let completionFunction) = argument.completion.kind
+      else { throw ParserError.invalidState }
+    
+    let site = CompletionKind.CompletionSite(
+      command: ObjectIdentifier(current), argument: argument.help.keys[0])
+    return completionFunction(completionValues, site)
   }
 }
 
@@ -0,0 +1,67 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+@_implementationOnly import Foundation
+
+/// A value that was parsed for an array argument, but not yet converted to
+/// the array's element type.
+struct PendingConversion {
+  var origin: InputOrigin
+  var name: Name?
+  var value: String
+}
+
+extension ArgumentDefinition {
+  /// Changes this array argument to collect its values while parsing, and
+  /// then convert all of them concurrently once parsing is finished.
+  ///
+  /// `convert` returns `nil` or throws an error for values that can't be
+  /// converted. Conversion errors are reported for the earliest failing
+  /// value in the input, regardless of which conversion finishes first.
+  mutating func convertValuesConcurrently<Element>(
+    forKey key: InputKey,
+    _ convert: @escaping (String) throws -> Element?
+  ) {
+    update = .unary { origin, name, value, parsedValues in
+      let pending = PendingConversion(origin: origin, name: name, value: value)
+      parsedValues.update(forKey: key, inputOrigin: origin, initial: [PendingConversion](), closure: {
+        $0.append(pending)
+      })
+    }
+
+    finalize = { parsedValues in
+      guard let pending = parsedValues.element(forKey: key)?.value as? [PendingConversion]
+        else { return }
+
+      var results = [Result<Element?, Error>?](repeating: nil, count: pending.count)
+      results.withUnsafeMutableBufferPointer { buffer in
+        let results = buffer
+        DispatchQueue.concurrentPerform(iterations: pending.count) { i in
+          results[i] = Result { try convert(pending[i].value) }
+        }
+      }
+
+      var elements: [Element] = []
+      elements.reserveCapacity(pending.count)
+      for (value, result) in zip(pending, results) {
+        switch result! {
+        case .success(let element?):
+          elements.append(element)
+        case .success(nil):
+          throw ParserError.unableToParseValue(value.origin, value.name, value.value, forKey: key)
+        case .failure(let error):
+          throw ParserError.unableToParseValue(value.origin, value.name, value.value, forKey: key, originalError: error)
+        }
+      }
+      parsedValues.replaceValue(forKey: key, with: elements)
+    }
+  }
+}
@@ -36,9 +36,13 @@ struct InputOrigin: Equatable, ExpressibleByArrayLiteral {
     /// The input value came from the specified index in the argument string.
     case argumentIndex(SplitArguments.Index)
     
+    /// The input value came from a value source other than the command line,
+    /// at the described location.
+    case valueSource(String)
+    
     var baseIndex: Int? {
       switch self {
-      case .defaultValue:
+      case .defaultValue, .valueSource:
         return nil
       case .argumentIndex(let i):
         return i.inputIndex.rawValue
@@ -47,7 +51,7 @@ struct InputOrigin: Equatable, ExpressibleByArrayLiteral {
     
     var subIndex: Int? {
       switch self {
-      case .defaultValue:
+      case .defaultValue, .valueSource:
         return nil
       case .argumentIndex(let i):
         switch i.subIndex {
@@ -58,20 +62,50 @@ struct InputOrigin: Equatable, ExpressibleByArrayLiteral {
     }
   }
   
-  private var _elements: Set<Element> = []
+  /// The elements of an input origin, kept sorted and without duplicates.
+  ///
+  /// Almost every origin has one or two elements, so those are stored
+  /// inline, without allocating. Since the storage is always in its smallest
+  /// form, two origins are equal exactly when their storage is equal.
+  private enum Storage: Equatable {
+    case empty
+    case one(Element)
+    case two(Element, Element)
+    case many([Element])
+  }
+  
+  private var storage: Storage = .empty
+  
+  /// The elements of this origin, in sorted order.
   var elements: [Element] {
-    Array(_elements).sorted()
+    switch storage {
+    case .empty: return []
+    case .one(let a): return [a]
+    case .two(let a, let b): return [a, b]
+    case .many(let elements): return elements
+    }
+  }
+  
+  /// The first element of this origin, in sorted order.
+  var first: Element? {
+    switch storage {
+    case .empty: return nil
+    case .one(let a), .two(let a, _): return a
+    case .many(let elements): return elements.first
+    }
   }
   
   init() {
   }
   
   init(elements: [Element]) {
-    _elements = Set(elements)
+    for element in elements {
+      insert(element)
+    }
   }
   
   init(element: Element) {
-    _elements = Set([element])
+    storage = .one(element)
   }
   
   init(arrayLiteral elements: Element...) {
@@ -83,29 +117,118 @@ struct InputOrigin: Equatable, ExpressibleByArrayLiteral {
   }
   
   mutating func insert(_ other: Element) {
-    guard !_elements.contains(other) else { return }
-    _elements.insert(other)
+    switch storage {
+    case .empty:
+      storage = .one(other)
+    case .one(let a):
+      if other < a {
+        storage = .two(other, a)
+      } else if a < other {
+        storage = .two(a, other)
+      }
+    case .two(let a, let b):
+      if other < a {
+        storage = .many([other, a, b])
+      } else if a < other && other < b {
+        storage = .many([a, other, b])
+      } else if b < other {
+        storage = .many([a, b, other])
+      }
+    case .many(var elements):
+      // Elements are usually inserted in input order, so check the end first.
+      if elements.last! < other {
+        storage = .empty
+        elements.append(other)
+        storage = .many(elements)
+        return
+      }
+      
+      let i = elements.insertionIndex(of: other)
+      guard elements[i] != other else { return }
+      
+      // Clear out the storage first so that `elements` is uniquely
+      // referenced and can be modified in place.
+      storage = .empty
+      elements.insert(other, at: i)
+      storage = .many(elements)
+    }
   }
   
   func inserting(_ other: Element) -> Self {
-    guard !_elements.contains(other) else { return self }
     var result = self
     result.insert(other)
     return result
   }
   
   mutating func formUnion(_ other: InputOrigin) {
-    _elements.formUnion(other._elements)
+    switch other.storage {
+    case .empty:
+      return
+    case .one(let a):
+      insert(a)
+    case .two(let a, let b):
+      insert(a)
+      insert(b)
+    case .many(let otherElements):
+      switch storage {
+      case .empty:
+        self = other
+      case .one, .two:
+        // Insert the smaller origin into the larger one.
+        let small = self
+        self = other
+        small.forEach { insert($0) }
+      case .many(var elements):
+        storage = .empty
+        if elements.last! < otherElements.first! {
+          elements.append(contentsOf: otherElements)
+        } else {
+          elements = elements.mergingSorted(with: otherElements)
+        }
+        storage = .many(elements)
+      }
+    }
   }
 
   func forEach(_ closure: (Element) -> Void) {
-    _elements.forEach(closure)
+    switch storage {
+    case .empty:
+      break
+    case .one(let a):
+      closure(a)
+    case .two(let a, let b):
+      closure(a)
+      closure(b)
+    case .many(let elements):
+      elements.forEach(closure)
+    }
   }
 }
 
 extension InputOrigin {
+  var isEmpty: Bool {
+    return storage == .empty
+  }
+
   var isDefaultValue: Bool {
-    return _elements.count == 1 && _elements.first == .defaultValue
+    return storage == .one(.defaultValue)
+  }
+
+  /// A Boolean value indicating whether any part of this origin is on the
+  /// command line.
+  var includesArgumentIndex: Bool {
+    // Argument indices sort before every other kind of element.
+    if case .argumentIndex = first { return true }
+    return false
+  }
+
+  /// The location of the first value source in this origin, if any.
+  var valueSourceLocation: String? {
+    var location: String?
+    forEach {
+      if location == nil, case .valueSource(let l) = $0 { location = l }
+    }
+    return location
   }
 }
 
@@ -114,10 +237,55 @@ extension InputOrigin.Element {
     switch (lhs, rhs) {
     case (.argumentIndex(let l), .argumentIndex(let r)):
       return l < r
-    case (.argumentIndex, .defaultValue):
+    case (.valueSource(let l), .valueSource(let r)):
+      return l < r
+    case (.argumentIndex, _), (.valueSource, .defaultValue):
       return true
-    case (.defaultValue, _):
+    case (.valueSource, .argumentIndex), (.defaultValue, _):
       return false
     }
   }
 }
+
+extension Array where Element == InputOrigin.Element {
+  /// Returns the index of the first element that isn't less than `element`,
+  /// using a binary search. The array must be sorted.
+  fileprivate func insertionIndex(of element: Element) -> Int {
+    var low = startIndex
+    var high = endIndex
+    while low < high {
+      let mid = low + (high - low) / 2
+      if self[mid] < element {
+        low = mid + 1
+      } else {
+        high = mid
+      }
+    }
+    return low
+  }
+  
+  /// Merges two sorted arrays without duplicates into a single sorted array
+  /// without duplicates.
+  fileprivate func mergingSorted(with other: [Element]) -> [Element] {
+    var result: [Element] = []
+    result.reserveCapacity(count + other.count)
+    var i = startIndex
+    var j = other.startIndex
+    while i < endIndex && j < other.endIndex {
+      if self[i] < other[j] {
+        result.append(self[i])
+        i += 1
+      } else if other[j] < self[i] {
+        result.append(other[j])
+        j += 1
+      } else {
+        result.append(self[i])
+        i += 1
+        j += 1
+      }
+    }
+    result.append(contentsOf: self[i...])
+    result.append(contentsOf: other[j...])
+    return result
+  }
+}
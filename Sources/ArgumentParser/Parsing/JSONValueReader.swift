@@ -0,0 +1,249 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// A reader for the flat JSON objects used as configuration files.
+///
+/// Values are read straight from the file's bytes into the strings that
+/// arguments are parsed from, so numbers keep their original text and no
+/// intermediate object graph is built. The scanning methods are also used
+/// to read compact help dumps; see `HelpInfo.init(compactDump:)`.
+struct JSONValueReader {
+  struct Error: Swift.Error, CustomStringConvertible {
+    var message: String
+    var offset: Int
+
+    var description: String {
+      "\(message) at offset \(offset)"
+    }
+  }
+
+  let bytes: UnsafeRawBufferPointer
+  var position = 0
+
+  init(_ bytes: UnsafeRawBufferPointer) {
+    self.bytes = bytes
+  }
+
+  /// Reads a JSON object, returning the values for each of its keys.
+  mutating func readTopLevelObject() throws -> [String: [String]] {
+    var result: [String: [String]] = [:]
+
+    try expect(UInt8(ascii: "{"))
+    if !consume(UInt8(ascii: "}")) {
+      repeat {
+        skipWhitespace()
+        let key = try readString()
+        try expect(UInt8(ascii: ":"))
+        // A `null` value leaves the key out, as if it weren't in the file.
+        result[key] = try readValues()
+      } while consume(UInt8(ascii: ","))
+      try expect(UInt8(ascii: "}"))
+    }
+
+    skipWhitespace()
+    guard position == bytes.count else {
+      throw error("Unexpected content after the top-level object")
+    }
+    return result
+  }
+
+  /// Reads the value for a key: a scalar, `null`, or an array of scalars.
+  private mutating func readValues() throws -> [String]? {
+    skipWhitespace()
+    guard consume(UInt8(ascii: "[")) else {
+      return try readScalar()
+    }
+
+    var values: [String] = []
+    if !consume(UInt8(ascii: "]")) {
+      repeat {
+        guard let value = try readScalar() else {
+          throw error("Arrays can't contain null")
+        }
+        values.append(contentsOf: value)
+      } while consume(UInt8(ascii: ","))
+      try expect(UInt8(ascii: "]"))
+    }
+    return values
+  }
+
+  /// Reads a string, number, or Boolean as a single value, or `null` as
+  /// `nil`.
+  private mutating func readScalar() throws -> [String]? {
+    skipWhitespace()
+    guard position < bytes.count else { throw error("Expected a value") }
+
+    switch bytes[position] {
+    case UInt8(ascii: "\""):
+      return [try readString()]
+    case UInt8(ascii: "-"), UInt8(ascii: "0")...UInt8(ascii: "9"):
+      return [readNumber()]
+    case UInt8(ascii: "t"):
+      try expectWord("true")
+      return ["true"]
+    case UInt8(ascii: "f"):
+      try expectWord("false")
+      return ["false"]
+    case UInt8(ascii: "n"):
+      try expectWord("null")
+      return nil
+    case UInt8(ascii: "{"), UInt8(ascii: "["):
+      throw error("Nested objects and arrays aren't supported")
+    default:
+      throw error("Expected a value")
+    }
+  }
+
+  mutating func readNumber() -> String {
+    let start = position
+    while position < bytes.count {
+      switch bytes[position] {
+      case UInt8(ascii: "0")...UInt8(ascii: "9"),
+           UInt8(ascii: "-"), UInt8(ascii: "+"), UInt8(ascii: "."),
+           UInt8(ascii: "e"), UInt8(ascii: "E"):
+        position += 1
+      default:
+        return String(decoding: UnsafeRawBufferPointer(rebasing: bytes[start..<position]), as: UTF8.self)
+      }
+    }
+    return String(decoding: UnsafeRawBufferPointer(rebasing: bytes[start..<position]), as: UTF8.self)
+  }
+
+  mutating func readString() throws -> String {
+    guard consume(UInt8(ascii: "\""), skippingWhitespace: false) else {
+      throw error("Expected a string")
+    }
+
+    // Strings without escapes, the most common kind, are decoded directly
+    // from the file's bytes.
+    let start = position
+    while position < bytes.count {
+      switch bytes[position] {
+      case UInt8(ascii: "\""):
+        let string = String(decoding: UnsafeRawBufferPointer(rebasing: bytes[start..<position]), as: UTF8.self)
+        position += 1
+        return string
+      case UInt8(ascii: "\\"):
+        return try readEscapedString(startingWith: Array(bytes[start..<position]))
+      default:
+        position += 1
+      }
+    }
+    throw error("Unterminated string")
+  }
+
+  private mutating func readEscapedString(startingWith prefix: [UInt8]) throws -> String {
+    var result = prefix
+    while position < bytes.count {
+      let byte = bytes[position]
+      position += 1
+
+      switch byte {
+      case UInt8(ascii: "\""):
+        return String(decoding: result, as: UTF8.self)
+      case UInt8(ascii: "\\"):
+        guard position < bytes.count else { throw error("Unterminated string") }
+        let escaped = bytes[position]
+        position += 1
+        switch escaped {
+        case UInt8(ascii: "\""), UInt8(ascii: "\\"), UInt8(ascii: "/"):
+          result.append(escaped)
+        case UInt8(ascii: "b"): result.append(0x08)
+        case UInt8(ascii: "f"): result.append(0x0C)
+        case UInt8(ascii: "n"): result.append(0x0A)
+        case UInt8(ascii: "r"): result.append(0x0D)
+        case UInt8(ascii: "t"): result.append(0x09)
+        case UInt8(ascii: "u"):
+          result.append(contentsOf: try readUnicodeEscape())
+        default:
+          throw error("Invalid escape sequence")
+        }
+      default:
+        result.append(byte)
+      }
+    }
+    throw error("Unterminated string")
+  }
+
+  /// Reads the hex digits after `\u`, and a second escape for the low half
+  /// of a surrogate pair, returning the UTF-8 encoding of the character.
+  private mutating func readUnicodeEscape() throws -> [UInt8] {
+    var scalarValue = UInt32(try readHexQuad())
+    if (0xD800...0xDBFF).contains(scalarValue) {
+      guard consume(UInt8(ascii: "\\"), skippingWhitespace: false),
+            consume(UInt8(ascii: "u"), skippingWhitespace: false)
+        else { throw error("Unpaired surrogate in escape sequence") }
+      let low = UInt32(try readHexQuad())
+      guard (0xDC00...0xDFFF).contains(low) else {
+        throw error("Unpaired surrogate in escape sequence")
+      }
+      scalarValue = 0x10000 + ((scalarValue - 0xD800) << 10) + (low - 0xDC00)
+    }
+
+    guard let scalar = Unicode.Scalar(scalarValue) else {
+      throw error("Invalid escape sequence")
+    }
+    return Array(String(Character(scalar)).utf8)
+  }
+
+  private mutating func readHexQuad() throws -> UInt16 {
+    guard position + 4 <= bytes.count else {
+      throw error("Invalid escape sequence")
+    }
+    let digits = String(decoding: UnsafeRawBufferPointer(rebasing: bytes[position..<position + 4]), as: UTF8.self)
+    guard let value = UInt16(digits, radix: 16) else {
+      throw error("Invalid escape sequence")
+    }
+    position += 4
+    return value
+  }
+
+  // MARK: Scanning
+
+  mutating func skipWhitespace() {
+    while position < bytes.count {
+      switch bytes[position] {
+      case UInt8(ascii: " "), UInt8(ascii: "\t"), UInt8(ascii: "\n"), UInt8(ascii: "\r"):
+        position += 1
+      default:
+        return
+      }
+    }
+  }
+
+  /// Consumes `byte` if it's next, returning whether it was.
+  mutating func consume(_ byte: UInt8, skippingWhitespace: Bool = true) -> Bool {
+    if skippingWhitespace {
+      self.skipWhitespace()
+    }
+    guard position < bytes.count, bytes[position] == byte else { return false }
+    position += 1
+    return true
+  }
+
+  mutating func expect(_ byte: UInt8) throws {
+    guard consume(byte) else {
+      throw error("Expected '\(Character(Unicode.Scalar(byte)))'")
+    }
+  }
+
+  mutating func expectWord(_ word: String) throws {
+    for byte in word.utf8 {
+      guard consume(byte, skippingWhitespace: false) else {
+        throw error("Expected '\(word)'")
+      }
+    }
+  }
+
+  func error(_ message: String) -> Error {
+    Error(message: message, offset: position)
+  }
+}
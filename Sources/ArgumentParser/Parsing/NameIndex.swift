@@ -0,0 +1,136 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// An index from the names of the arguments in an argument set to their
+/// positions in the set.
+///
+/// Each kind of name is stored separately, so lookups hash a plain `String`
+/// or `Character` rather than a `Name`. ASCII short names, the most common
+/// kind, use a fixed table indexed by code unit. When more than one argument
+/// uses the same name, the index keeps the first one.
+struct NameIndex {
+  /// The positions for ASCII short names, indexed by code unit, with `-1`
+  /// for unused names. Empty until the first ASCII short name is inserted.
+  private var asciiShortNames: [Int32] = []
+
+  /// The positions for non-ASCII short names.
+  private var otherShortNames: [Character: Int] = [:]
+
+  /// The positions for names prefixed with `--`.
+  private var longNames: [String: Int] = [:]
+
+  /// The positions for long names prefixed with `-`.
+  private var singleDashLongNames: [String: Int] = [:]
+
+  /// The keys of `longNames`, in sorted order, for finding abbreviations.
+  private var sortedLongNames: [String] = []
+
+  init() {}
+
+  init<S: Sequence>(_ names: S) where S.Element == (Name, Int) {
+    for (name, position) in names {
+      insert(name, at: position, keepingSortOrder: false)
+    }
+    sortedLongNames.sort()
+  }
+
+  /// Adds `name` for the argument at `position`, unless the name is already
+  /// in the index.
+  mutating func insert(_ name: Name, at position: Int) {
+    insert(name, at: position, keepingSortOrder: true)
+  }
+
+  private mutating func insert(_ name: Name, at position: Int, keepingSortOrder: Bool) {
+    switch name {
+    case .short(let c, _):
+      if let ascii = c.asciiValue {
+        if asciiShortNames.isEmpty {
+          asciiShortNames = Array(repeating: -1, count: 128)
+        }
+        if asciiShortNames[Int(ascii)] < 0 {
+          asciiShortNames[Int(ascii)] = Int32(position)
+        }
+      } else if otherShortNames[c] == nil {
+        otherShortNames[c] = position
+      }
+
+    case .long(let n):
+      guard longNames[n] == nil else { return }
+      longNames[n] = position
+      if keepingSortOrder {
+        sortedLongNames.insert(n, at: sortedLongNames.lowerBound(of: n))
+      } else {
+        sortedLongNames.append(n)
+      }
+
+    case .longWithSingleDash(let n):
+      if singleDashLongNames[n] == nil {
+        singleDashLongNames[n] = position
+      }
+    }
+  }
+
+  /// Returns the position of the argument with the given name, if any.
+  func position(of name: Name) -> Int? {
+    switch name {
+    case .short(let c, _):
+      if let ascii = c.asciiValue {
+        guard !asciiShortNames.isEmpty else { return nil }
+        let position = asciiShortNames[Int(ascii)]
+        return position < 0 ? nil : Int(position)
+      }
+      return otherShortNames[c]
+    case .long(let n):
+      return longNames[n]
+    case .longWithSingleDash(let n):
+      return singleDashLongNames[n]
+    }
+  }
+
+  /// Returns the position of the only argument with a `--`-prefixed name
+  /// that starts with `prefix`, if there is exactly one.
+  ///
+  /// An argument can have more than one name starting with `prefix`; it's
+  /// still an unambiguous match.
+  func position(ofLongNameWithPrefix prefix: String) -> Int? {
+    guard !prefix.isEmpty else { return nil }
+
+    var match: Int?
+    var i = sortedLongNames.lowerBound(of: prefix)
+    while i < sortedLongNames.endIndex, sortedLongNames[i].hasPrefix(prefix) {
+      let position = longNames[sortedLongNames[i]]!
+      if let match = match, match != position {
+        return nil
+      }
+      match = position
+      i += 1
+    }
+    return match
+  }
+}
+
+extension Array where Element == String {
+  /// Returns the first index in this sorted array whose element isn't less
+  /// than `value`.
+  fileprivate func lowerBound(of value: String) -> Int {
+    var low = startIndex
+    var high = endIndex
+    while low < high {
+      let mid = low + (high - low) / 2
+      if self[mid] < value {
+        low = mid + 1
+      } else {
+        high = mid
+      }
+    }
+    return low
+  }
+}
@@ -65,6 +65,17 @@ extension ParsedWrapper {
 
 extension ParsedWrapper where Value: Decodable {
   init(_decoder: Decoder) throws {
+    // For standard library values, `Value.init(from:)` would only cast the
+    // parsed value after building a decoding container, so use the parsed
+    // value directly. Other types may have a custom `init(from:)`, which
+    // still has to be called.
+    if Value.self is DirectlyDecodableValue.Type,
+      let d = _decoder as? SingleValueDecoder,
+      let v = d.parsedElement?.value as? Value {
+      self.init(_parsedValue: .value(v))
+      return
+    }
+    
     var value: Value
     
     do {
@@ -81,3 +92,24 @@ extension ParsedWrapper where Value: Decodable {
     self.init(_parsedValue: .value(value))
   }
 }
+
+/// A standard library type whose `init(from:)` produces the parsed value
+/// unchanged, so that property wrappers can skip calling it.
+internal protocol DirectlyDecodableValue {}
+
+extension Bool: DirectlyDecodableValue {}
+extension String: DirectlyDecodableValue {}
+extension Double: DirectlyDecodableValue {}
+extension Float: DirectlyDecodableValue {}
+extension Int: DirectlyDecodableValue {}
+extension Int8: DirectlyDecodableValue {}
+extension Int16: DirectlyDecodableValue {}
+extension Int32: DirectlyDecodableValue {}
+extension Int64: DirectlyDecodableValue {}
+extension UInt: DirectlyDecodableValue {}
+extension UInt8: DirectlyDecodableValue {}
+extension UInt16: DirectlyDecodableValue {}
+extension UInt32: DirectlyDecodableValue {}
+extension UInt64: DirectlyDecodableValue {}
+extension Optional: DirectlyDecodableValue where Wrapped: DirectlyDecodableValue {}
+extension Array: DirectlyDecodableValue where Element: DirectlyDecodableValue {}
@@ -50,13 +50,16 @@ extension ParsedValues {
   }
   
   mutating func set(_ element: Element) {
-    if let e = elements[element.key] {
+    if var merged = elements.removeValue(forKey: element.key) {
       // Merge the source values. We need to keep track
       // of any previous source indexes we have used for
-      // this key.
-      var element = element
-      element.inputOrigin.formUnion(e.inputOrigin)
-      elements[element.key] = element
+      // this key. The new origin is merged into the existing one, which is
+      // usually the larger of the two, after removing it from `elements` so
+      // that it can be updated in place.
+      merged.value = element.value
+      merged.shouldClearArrayIfParsed = element.shouldClearArrayIfParsed
+      merged.inputOrigin.formUnion(element.inputOrigin)
+      elements[element.key] = merged
     } else {
       elements[element.key] = element
     }
@@ -66,26 +69,45 @@ extension ParsedValues {
     elements[key]
   }
   
+  /// Replaces the value for `key`, if there is one, keeping its origin.
+  mutating func replaceValue(forKey key: InputKey, with value: Any?) {
+    elements[key]?.value = value
+  }
+  
   mutating func update<A>(forKey key: InputKey, inputOrigin: InputOrigin, initial: A, closure: (inout A) -> Void) {
-    var e = element(forKey: key) ?? Element(key: key, value: initial, inputOrigin: InputOrigin())
-    var v = (e.value as? A ) ?? initial
-    closure(&v)
-    e.value = v
-    e.inputOrigin.formUnion(inputOrigin)
-    set(e)
+    updateInPlace(forKey: key, inputOrigin: inputOrigin) { e in
+      var v = (e.value as? A) ?? initial
+      e.value = nil
+      closure(&v)
+      e.value = v
+    }
   }
   
   mutating func update<A>(forKey key: InputKey, inputOrigin: InputOrigin, initial: [A], closure: (inout [A]) -> Void) {
-    var e = element(forKey: key) ?? Element(key: key, value: initial, inputOrigin: InputOrigin())
-    var v = (e.value as? [A] ) ?? initial
-    // The first time a value is parsed from command line, empty array of any default values.
-    if e.shouldClearArrayIfParsed {
-      v.removeAll()
-      e.shouldClearArrayIfParsed = false
+    updateInPlace(forKey: key, inputOrigin: inputOrigin) { e in
+      var v = (e.value as? [A]) ?? initial
+      e.value = nil
+      // The first time a value is parsed from command line, empty array of any default values.
+      if e.shouldClearArrayIfParsed {
+        v.removeAll()
+        e.shouldClearArrayIfParsed = false
+      }
+      closure(&v)
+      e.value = v
     }
-    closure(&v)
-    e.value = v
+  }
+  
+  /// Updates the element for `key`, adding `inputOrigin` to its origins.
+  ///
+  /// The element is removed from `elements` while `body` runs, so that its
+  /// value and origin are uniquely referenced. Clearing `value` before
+  /// modifying a copy of it lets collections like arrays grow in place,
+  /// instead of being copied for every repeated option.
+  private mutating func updateInPlace(forKey key: InputKey, inputOrigin: InputOrigin, _ body: (inout Element) -> Void) {
+    var e = elements.removeValue(forKey: key)
+      ?? Element(key: key, value: nil, inputOrigin: InputOrigin())
+    body(&e)
     e.inputOrigin.formUnion(inputOrigin)
-    set(e)
+    elements[key] = e
   }
 }
@@ -14,8 +14,10 @@ enum ParserError: Error {
   case helpRequested
   case versionRequested
   case dumpHelpRequested
+  case compactDumpHelpRequested
   
   case completionScriptRequested(shell: String?)
+  case completionShimRequested(shell: String?)
   case completionScriptCustomResponse(String)
   case unsupportedShell(String? = nil)
   
@@ -28,6 +30,8 @@ enum ParserError: Error {
   case missingValueForOption(InputOrigin, Name)
   case unexpectedValueForOption(InputOrigin.Element, Name, String)
   case unexpectedExtraValues([(InputOrigin, String)])
+  /// An extra value was given to a command with subcommands, and it's close to one of the subcommand names.
+  case unknownSubcommand(InputOrigin, String, suggestion: String)
   case duplicateExclusiveValues(previous: InputOrigin, duplicate: InputOrigin, originalInput: [String])
   /// We need a value for the given key, but it’s not there. Some non-optional option or argument is missing.
   case noValue(forKey: InputKey)
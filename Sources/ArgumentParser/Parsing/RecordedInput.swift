@@ -0,0 +1,167 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+@_implementationOnly import Foundation
+
+/// The input for an argument set, recorded while parsing so that it can be
+/// converted later.
+struct RecordedInput {
+  struct Record {
+    /// The position of the argument in `arguments`.
+    var position: Int
+    var origin: InputOrigin
+    var name: Name?
+    var value: String?
+  }
+
+  var arguments: ArgumentSet
+  var records: [Record] = []
+
+  /// Returns the values for the recorded input, running each argument's
+  /// updates in the order that the input was parsed.
+  func replay(originalInput: [String]) throws -> ParsedValues {
+    var result = ParsedValues(elements: [:], originalInput: originalInput)
+    try arguments.setInitialValues(into: &result)
+
+    // Values from value sources are recorded after the command line's
+    // input, but the command line takes precedence, including for other
+    // arguments with the same key, such as an inverted flag.
+    var keysOnCommandLine: Set<InputKey> = []
+    for record in records where record.origin.includesArgumentIndex {
+      keysOnCommandLine.formUnion(arguments[record.position].help.keys)
+    }
+
+    for record in records {
+      if record.origin.valueSourceLocation != nil,
+         arguments[record.position].help.keys.contains(where: { keysOnCommandLine.contains($0) })
+      {
+        continue
+      }
+
+      switch arguments[record.position].update {
+      case let .nullary(update):
+        try update(record.origin, record.name, &result)
+      case let .unary(update):
+        try update(record.origin, record.name, record.value ?? "", &result)
+      }
+    }
+
+    for argument in arguments {
+      try argument.finalize?(&result)
+    }
+    return result
+  }
+}
+
+extension ArgumentSet {
+  /// Returns a copy of this argument set that records its input as a
+  /// `RecordedInput` value for `key`, instead of converting it.
+  ///
+  /// The copy parses exactly the same input as this set, and has the same
+  /// help, so only the values it produces differ.
+  func recordingInput(forKey key: InputKey) -> ArgumentSet {
+    let original = self
+
+    return ArgumentSet(content.enumerated().map { position, argument in
+      var argument = argument
+      argument.finalize = nil
+
+      // The first argument stands in for the whole set, so that the value
+      // for `key` exists even when none of the arguments are given.
+      if position == 0 {
+        argument.initial = { origin, values in
+          values.set(RecordedInput(arguments: original), forKey: key, inputOrigin: origin)
+        }
+      } else {
+        argument.initial = { _, _ in }
+      }
+
+      func record(_ origin: InputOrigin, _ name: Name?, _ value: String?, _ values: inout ParsedValues) {
+        let record = RecordedInput.Record(position: position, origin: origin, name: name, value: value)
+        values.update(forKey: key, inputOrigin: origin, initial: RecordedInput(arguments: original), closure: {
+          $0.records.append(record)
+        })
+      }
+
+      switch argument.update {
+      case .nullary:
+        argument.update = .nullary { origin, name, values in
+          record(origin, name, nil, &values)
+        }
+      case .unary:
+        argument.update = .unary { origin, name, value, values in
+          record(origin, name, value, &values)
+        }
+      }
+      return argument
+    })
+  }
+}
+
+/// A parsable type that is decoded from recorded input the first time its
+/// value is requested.
+final class LazyDecodedArguments<Value: ParsableArguments> {
+  private let lock = NSLock()
+  private var input: RecordedInput?
+  private let originalInput: [String]
+  private let commandStack: [ParsableCommand.Type]
+  private var result: Result<Value, Error>?
+
+  init(input: RecordedInput, originalInput: [String], commandStack: [ParsableCommand.Type]) {
+    self.input = input
+    self.originalInput = originalInput
+    self.commandStack = commandStack
+  }
+
+  /// The type that reports errors in this group's values.
+  var rootCommand: ParsableArguments.Type {
+    commandStack.first ?? Value.self
+  }
+
+  /// Returns the decoded and validated value, decoding it on the first
+  /// call and returning the same value, or error, afterward.
+  ///
+  /// Errors are thrown as a `CommandError` for the commands that were
+  /// parsed, so that they have the same message and usage as errors found
+  /// during parsing.
+  func value() throws -> Value {
+    lock.lock()
+    defer { lock.unlock() }
+
+    if let result = result {
+      return try result.get()
+    }
+
+    let input = self.input!
+    let commandStack = self.commandStack
+    let result = Result { () throws -> Value in
+      do {
+        let values = try input.replay(originalInput: originalInput)
+        var value = try Value(from: ArgumentDecoder(values: values))
+        do {
+          try value.validate()
+        } catch {
+          throw ParserError.userValidationError(error)
+        }
+        return value
+      } catch let error as CommandError {
+        throw error
+      } catch let error as ParserError where !commandStack.isEmpty {
+        throw CommandError(commandStack: commandStack, parserError: error)
+      } catch let error where !commandStack.isEmpty {
+        throw CommandError(commandStack: commandStack, parserError: .userValidationError(error))
+      }
+    }
+    self.result = result
+    self.input = nil
+    return try result.get()
+  }
+}
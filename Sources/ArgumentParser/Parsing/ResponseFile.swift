@@ -0,0 +1,243 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#elseif canImport(CRT)
+import CRT
+#endif
+
+/// Expands `@path` arguments into the arguments listed in the file at
+/// `path`.
+///
+/// A response file holds arguments separated by whitespace. Single quotes
+/// preserve everything up to the closing quote, and a backslash escapes the
+/// next character, both outside of quotes and within double quotes. Response
+/// files can refer to other response files, and arguments after a `--`
+/// terminator are never expanded.
+struct ResponseFileExpander {
+  /// The deepest that response files can refer to other response files.
+  static let maximumDepth = 16
+
+  /// The most bytes that can be read from response files in one expansion.
+  static let maximumTotalSize = 64 << 20
+
+  private var openPaths: [String] = []
+  private var totalSize = 0
+  private var isAfterTerminator = false
+  private var result: [String] = []
+
+  /// Returns `arguments`, with every response file replaced by its
+  /// contents.
+  static func expand(_ arguments: [String]) throws -> [String] {
+    guard arguments.contains(where: { $0.hasPrefix("@") }) else { return arguments }
+
+    var expander = ResponseFileExpander()
+    expander.result.reserveCapacity(arguments.count)
+    for argument in arguments {
+      try expander.append(argument, location: nil)
+    }
+    return expander.result
+  }
+
+  private mutating func append(_ argument: String, location: (path: String, line: Int)?) throws {
+    if argument == "--" {
+      isAfterTerminator = true
+    }
+    guard !isAfterTerminator, argument.count > 1, argument.first == "@" else {
+      result.append(argument)
+      return
+    }
+
+    let path = String(argument.dropFirst())
+    guard !openPaths.contains(path) else {
+      throw ResponseFileExpander.error("Response file '\(path)' includes itself", at: location)
+    }
+    guard openPaths.count < ResponseFileExpander.maximumDepth else {
+      throw ResponseFileExpander.error("Response files are nested more than \(ResponseFileExpander.maximumDepth) levels deep", at: location)
+    }
+
+    let contents = try read(path, location: location)
+    openPaths.append(path)
+    defer { openPaths.removeLast() }
+    try ResponseFileExpander.tokenize(contents, path: path) { token, line in
+      try append(token, location: (path, line))
+    }
+  }
+
+  /// Reads the entire file at `path` into a single buffer.
+  private mutating func read(_ path: String, location: (path: String, line: Int)?) throws -> [UInt8] {
+    guard let file = fopen(path, "rb") else {
+      throw ResponseFileExpander.error("Couldn't open response file '\(path)'", at: location)
+    }
+    defer { fclose(file) }
+
+    // A regular file reports its size, so it can be read with a single call.
+    // Pipes, such as `@/dev/stdin` or `@<(command)`, can't seek, and some
+    // special files report a size of zero, so those are read in chunks.
+    var size = -1
+    if fseek(file, 0, SEEK_END) == 0 {
+      size = Int(ftell(file))
+      rewind(file)
+    }
+    guard size > 0 else {
+      return try readChunks(from: file, path: path, location: location)
+    }
+
+    try addToTotalSize(size, location: location)
+    var contents = [UInt8](repeating: 0, count: size)
+    let count = contents.withUnsafeMutableBytes {
+      fread($0.baseAddress, 1, size, file)
+    }
+    guard count == size else {
+      throw ResponseFileExpander.error("Couldn't read response file '\(path)'", at: location)
+    }
+    return contents
+  }
+
+  /// Reads `file` until its end, for files that don't report their size.
+  private mutating func readChunks(
+    from file: UnsafeMutablePointer<FILE>,
+    path: String,
+    location: (path: String, line: Int)?
+  ) throws -> [UInt8] {
+    var contents: [UInt8] = []
+    var chunk = [UInt8](repeating: 0, count: 64 << 10)
+    while true {
+      let count = chunk.withUnsafeMutableBytes {
+        fread($0.baseAddress, 1, $0.count, file)
+      }
+      // The limit is checked as the file is read, so a pipe that never ends
+      // stops at the limit rather than exhausting memory.
+      try addToTotalSize(count, location: location)
+      contents.append(contentsOf: chunk[..<count])
+
+      if count < chunk.count {
+        guard ferror(file) == 0 else {
+          throw ResponseFileExpander.error("Couldn't read response file '\(path)'", at: location)
+        }
+        return contents
+      }
+    }
+  }
+
+  /// Counts `size` more bytes toward `maximumTotalSize`, throwing an error
+  /// if that exceeds the limit.
+  private mutating func addToTotalSize(_ size: Int, location: (path: String, line: Int)?) throws {
+    totalSize += size
+    guard totalSize <= ResponseFileExpander.maximumTotalSize else {
+      throw ResponseFileExpander.error("Response files are larger than \(ResponseFileExpander.maximumTotalSize >> 20) MB", at: location)
+    }
+  }
+
+  private static func error(_ message: String, at location: (path: String, line: Int)?) -> ParserError {
+    let message = location.map { "\($0.path):\($0.line): \(message)" } ?? message
+    return .userValidationError(ValidationError(message))
+  }
+}
+
+extension ResponseFileExpander {
+  /// Calls `body` with each argument in `contents` and the line it starts
+  /// on.
+  ///
+  /// Arguments without quotes or escapes, the most common kind, are decoded
+  /// directly from `contents`; the others are gathered into a single scratch
+  /// buffer that's reused for every argument.
+  static func tokenize(_ contents: [UInt8], path: String, _ body: (String, Int) throws -> Void) throws {
+    let newline = UInt8(ascii: "\n")
+    let backslash = UInt8(ascii: "\\")
+    let singleQuote = UInt8(ascii: "'")
+    let doubleQuote = UInt8(ascii: "\"")
+
+    func isWhitespace(_ byte: UInt8) -> Bool {
+      switch byte {
+      case UInt8(ascii: " "), UInt8(ascii: "\t"), newline, UInt8(ascii: "\r"), 0x0B, 0x0C:
+        return true
+      default:
+        return false
+      }
+    }
+
+    var scratch: [UInt8] = []
+    var i = contents.startIndex
+    var line = 1
+
+    while true {
+      while i < contents.endIndex, isWhitespace(contents[i]) {
+        if contents[i] == newline { line += 1 }
+        i += 1
+      }
+      guard i < contents.endIndex else { return }
+
+      let start = i
+      let startLine = line
+      var isSimple = true
+      var quote: UInt8?
+      scratch.removeAll(keepingCapacity: true)
+
+      func beginScratch() {
+        if isSimple {
+          scratch.append(contentsOf: contents[start..<i])
+          isSimple = false
+        }
+      }
+
+      scanning:
+      while i < contents.endIndex {
+        let byte = contents[i]
+
+        if let q = quote {
+          if byte == q {
+            quote = nil
+          } else if byte == backslash, q == doubleQuote, i + 1 < contents.endIndex {
+            i += 1
+            if contents[i] == newline { line += 1 }
+            scratch.append(contents[i])
+          } else {
+            if byte == newline { line += 1 }
+            scratch.append(byte)
+          }
+          i += 1
+          continue
+        }
+
+        switch byte {
+        case _ where isWhitespace(byte):
+          break scanning
+        case singleQuote, doubleQuote:
+          beginScratch()
+          quote = byte
+        case backslash:
+          beginScratch()
+          if i + 1 < contents.endIndex {
+            i += 1
+            if contents[i] == newline { line += 1 }
+            scratch.append(contents[i])
+          }
+        default:
+          if !isSimple { scratch.append(byte) }
+        }
+        i += 1
+      }
+
+      guard quote == nil else {
+        throw error("Missing closing quote", at: (path, startLine))
+      }
+
+      let token = isSimple
+        ? String(decoding: contents[start..<i], as: UTF8.self)
+        : String(decoding: scratch, as: UTF8.self)
+      try body(token, startLine)
+    }
+  }
+}
@@ -12,11 +12,14 @@
 /// A single `-f`, `--foo`, or `--foo=bar`.
 ///
 /// When parsing, we might see `"--foo"` or `"--foo=bar"`.
+///
+/// An attached value is kept as a slice of the original argument, sharing
+/// its storage, and only becomes a separate `String` when it's consumed.
 enum ParsedArgument: Equatable, CustomStringConvertible {
   /// `--foo` or `-f`
   case name(Name)
   /// `--foo=bar`
-  case nameWithValue(Name, String)
+  case nameWithValue(Name, Substring)
   
   init<S: StringProtocol>(_ str: S) where S.SubSequence == Substring {
     let indexOfEqualSign = str.firstIndex(of: "=") ?? str.endIndex
@@ -24,29 +27,19 @@ enum ParsedArgument: Equatable, CustomStringConvertible {
     let name = Name(baseName)
     self = value.isEmpty
       ? .name(name)
-      : .nameWithValue(name, String(value))
+      : .nameWithValue(name, value)
   }
   
-  /// An array of short arguments and their indices in the original base
-  /// name, if this argument could be a combined pack of short arguments.
+  /// A Boolean value indicating whether this argument could be a combined
+  /// pack of short arguments.
   ///
-  /// For `subarguments` to be non-empty:
+  /// For this to be `true`:
   ///
   /// 1) This must have a single-dash prefix (not `--foo`)
   /// 2) This must not have an attached value (not `-foo=bar`)
-  var subarguments: [(Int, ParsedArgument)] {
-    switch self {
-    case .nameWithValue: return []
-    case .name(let name):
-      switch name {
-      case .longWithSingleDash(let base):
-        return base.enumerated().map {
-          ($0, .name(.short($1)))
-        }
-      case .long, .short:
-        return []
-      }
-    }
+  var isShortOptionPack: Bool {
+    guard case .name(.longWithSingleDash) = self else { return false }
+    return true
   }
   
   var name: Name {
@@ -59,7 +52,7 @@ enum ParsedArgument: Equatable, CustomStringConvertible {
   var value: String? {
     switch self {
     case .name: return nil
-    case let .nameWithValue(_, v): return v
+    case let .nameWithValue(_, v): return String(v)
     }
   }
 
@@ -169,16 +162,79 @@ struct SplitArguments {
     }
   }
   
-  /// The parsed arguments. Onl
+  /// The parsed arguments, in input order.
+  ///
+  /// Elements are never moved or removed from this array; instead, using an
+  /// element marks it in `_isUsed`, so that removal is a constant-time
+  /// operation.
   var _elements: [Element] = []
+  
+  /// Whether each element in `_elements` has been used.
+  var _isUsed: [Bool] = []
+  
+  /// The position in `_elements` of the first element for each input index.
+  ///
+  /// Every input index has at least one element, and all of the elements for
+  /// an input index are adjacent, so the elements for input index `i` are at
+  /// the positions `_inputPositions[i]..<_inputPositions[i + 1]`.
+  var _inputPositions: [Int] = []
+  
+  /// The position of the first unused element.
   var firstUnused: Int = 0
+  
+  /// The number of unused elements.
+  var unusedCount: Int = 0
 
   /// The original array of arguments that was used to generate this instance.
   var originalInput: [String]
 
+  init(originalInput: [String]) {
+    self.originalInput = originalInput
+  }
+  
   /// The unused arguments represented by this instance.
-  var elements: ArraySlice<Element> {
-    _elements[firstUnused...]
+  ///
+  /// The indices of this collection are positions in the full list of
+  /// elements, so an index stays valid when other elements are removed.
+  var elements: Elements {
+    Elements(
+      base: _elements,
+      isUsed: _isUsed,
+      startIndex: firstUnused,
+      count: unusedCount)
+  }
+}
+
+extension SplitArguments {
+  /// A view of the unused elements of a `SplitArguments` instance.
+  struct Elements: BidirectionalCollection {
+    fileprivate var base: [Element]
+    fileprivate var isUsed: [Bool]
+    var startIndex: Int
+    var count: Int
+    
+    var endIndex: Int { base.endIndex }
+    var isEmpty: Bool { count == 0 }
+    
+    subscript(position: Int) -> Element {
+      base[position]
+    }
+    
+    func index(after i: Int) -> Int {
+      var i = i + 1
+      while i < endIndex && isUsed[i] {
+        i += 1
+      }
+      return i
+    }
+    
+    func index(before i: Int) -> Int {
+      var i = i - 1
+      while i > startIndex && isUsed[i] {
+        i -= 1
+      }
+      return i
+    }
   }
 }
 
@@ -245,16 +301,16 @@ extension SplitArguments.Element {
 extension SplitArguments {
   /// `true` if the arguments are empty.
   var isEmpty: Bool {
-    elements.isEmpty
+    unusedCount == 0
   }
 
   /// `false` if the arguments are empty, or if the only remaining argument is
   /// the `--` terminator.
   var containsNonTerminatorArguments: Bool {
-    if elements.isEmpty { return false }
-    if elements.count > 1 { return true }
+    if unusedCount == 0 { return false }
+    if unusedCount > 1 { return true }
     
-    if elements.first?.isTerminator == true { return false }
+    if peekNext()?.1.isTerminator == true { return false }
     else { return true }
   }
 
@@ -267,27 +323,67 @@ extension SplitArguments {
     return originalInput[index.inputIndex.rawValue]
   }
   
+  /// Returns the range of positions in `_elements` for the given input index.
+  private func positions(for inputIndex: InputIndex) -> Range<Int> {
+    let i = inputIndex.rawValue
+    guard i >= 0 && i < _inputPositions.count else {
+      return _elements.endIndex..<_elements.endIndex
+    }
+    let end = i + 1 < _inputPositions.count
+      ? _inputPositions[i + 1]
+      : _elements.endIndex
+    return _inputPositions[i]..<end
+  }
+  
+  /// Returns the position of the first unused element at or after `position`
+  /// that matches the given predicate.
+  ///
+  /// This reads the storage directly instead of going through `elements`, so
+  /// that a removal right afterward doesn't need to copy the storage.
+  private func firstUnusedPosition(
+    from position: Int,
+    where predicate: (Element) -> Bool = { _ in true }
+  ) -> Int? {
+    var i = max(position, firstUnused)
+    while i < _elements.endIndex {
+      if !_isUsed[i] && predicate(_elements[i]) { return i }
+      i += 1
+    }
+    return nil
+  }
+  
   /// Returns the position in `elements` of the given input origin.
   mutating func position(of origin: InputOrigin.Element) -> Int? {
     guard case let .argumentIndex(index) = origin else { return nil }
-    return elements.firstIndex(where: { $0.index == index })
+    return positions(for: index.inputIndex).first(where: {
+      !_isUsed[$0] && _elements[$0].index == index
+    })
   }
   
   /// Returns the position in `elements` of the first element after the given
   /// input origin.
   mutating func position(after origin: InputOrigin.Element) -> Int? {
     guard case let .argumentIndex(index) = origin else { return nil }
-    return elements.firstIndex(where: { $0.index > index })
+    let i = index.inputIndex.rawValue
+    guard i < _inputPositions.count else { return nil }
+    
+    // Skip past any elements for the same input index that don't come after
+    // `index`, then find the first element that's still unused.
+    let range = positions(for: index.inputIndex)
+    let start = range.first(where: { _elements[$0].index > index })
+      ?? range.upperBound
+    return firstUnusedPosition(from: start)
   }
   
   mutating func popNext() -> (InputOrigin.Element, Element)? {
-    guard let element = elements.first else { return nil }
+    guard let next = peekNext() else { return nil }
     removeFirst()
-    return (.argumentIndex(element.index), element)
+    return next
   }
   
   func peekNext() -> (InputOrigin.Element, Element)? {
-    guard let element = elements.first else { return nil }
+    guard firstUnused < _elements.endIndex else { return nil }
+    let element = _elements[firstUnused]
     return (.argumentIndex(element.index), element)
   }
   
@@ -322,15 +418,15 @@ extension SplitArguments {
     // packed short options can be followed, in order, by their values.
     // e.g. "-fn f-value n-value"
     guard let start = position(after: origin),
-      let elementIndex = elements[start...].firstIndex(where: { $0.index.subIndex == .complete })
+      let elementIndex = firstUnusedPosition(from: start, where: { $0.index.subIndex == .complete })
       else { return nil }
     
     // Only succeed if the element is a value (not prefixed with a dash)
-    guard case .value(let value) = elements[elementIndex].value
+    guard case .value(let value) = _elements[elementIndex].value
       else { return nil }
 
     defer { remove(at: elementIndex) }
-    let matchedArgumentIndex = elements[elementIndex].index
+    let matchedArgumentIndex = _elements[elementIndex].index
     return (.argumentIndex(matchedArgumentIndex), value)
   }
   
@@ -339,10 +435,10 @@ extension SplitArguments {
   /// This is used to get the next value in `-f -b name` where `name` is the value of `-f`.
   mutating func popNextValue(after origin: InputOrigin.Element) -> (InputOrigin.Element, String)? {
     guard let start = position(after: origin) else { return nil }
-    guard let resultIndex = elements[start...].firstIndex(where: { $0.isValue }) else { return nil }
+    guard let resultIndex = firstUnusedPosition(from: start, where: { $0.isValue }) else { return nil }
     
     defer { remove(at: resultIndex) }
-    return (.argumentIndex(elements[resultIndex].index), elements[resultIndex].value.valueString!)
+    return (.argumentIndex(_elements[resultIndex].index), _elements[resultIndex].value.valueString!)
   }
   
   /// Pops the element after the given index as a value.
@@ -356,7 +452,8 @@ extension SplitArguments {
     guard let start = position(after: origin) else { return nil }
     // Elements are sorted by their `InputIndex`. Find the first `InputIndex`
     // after `origin`:
-    guard let nextIndex = elements[start...].first(where: { $0.index.subIndex == .complete })?.index else { return nil }
+    guard let nextPosition = firstUnusedPosition(from: start, where: { $0.index.subIndex == .complete }) else { return nil }
+    let nextIndex = _elements[nextPosition].index
     // Remove all elements with this `InputIndex`:
     remove(at: nextIndex)
     // Return the original input
@@ -368,9 +465,9 @@ extension SplitArguments {
   /// If the current elements are `--b foo`, this will return `nil`. If the
   /// elements are `foo --b`, this will return the value `foo`.
   mutating func popNextElementIfValue() -> (InputOrigin.Element, String)? {
-    guard let element = elements.first, element.isValue else { return nil }
+    guard let (origin, element) = peekNext(), element.isValue else { return nil }
     removeFirst()
-    return (.argumentIndex(element.index), element.value.valueString!)
+    return (origin, element.value.valueString!)
   }
   
   /// Finds and "pops" the next element that is a value.
@@ -378,53 +475,49 @@ extension SplitArguments {
   /// If the current elements are `--a --b foo`, this will remove and return
   /// `foo`.
   mutating func popNextValue() -> (Index, String)? {
-    guard let idx = elements.firstIndex(where: { $0.isValue })
+    guard let idx = firstUnusedPosition(from: firstUnused, where: { $0.isValue })
       else { return nil }
-    let e = elements[idx]
+    let e = _elements[idx]
     remove(at: idx)
     return (e.index, e.value.valueString!)
   }
   
   /// Finds and returns the next element that is a value.
   func peekNextValue() -> (Index, String)? {
-    guard let idx = elements.firstIndex(where: { $0.isValue })
+    guard let idx = firstUnusedPosition(from: firstUnused, where: { $0.isValue })
       else { return nil }
-    let e = elements[idx]
+    let e = _elements[idx]
     return (e.index, e.value.valueString!)
   }
   
   /// Removes the first element in `elements`.
   mutating func removeFirst() {
-    firstUnused += 1
+    remove(at: firstUnused)
   }
   
   /// Removes the element at the given position.
   mutating func remove(at position: Int) {
-    guard position >= firstUnused else {
-      return
-    }
+    guard position >= firstUnused,
+      position < _elements.endIndex,
+      !_isUsed[position]
+      else { return }
     
-    // This leaves duplicates of still to-be-used arguments in the unused
-    // portion of the _elements array.
-    for i in (firstUnused..<position).reversed() {
-      _elements[i + 1] = _elements[i]
+    _isUsed[position] = true
+    unusedCount -= 1
+    
+    if position == firstUnused {
+      firstUnused += 1
+      while firstUnused < _elements.endIndex && _isUsed[firstUnused] {
+        firstUnused += 1
+      }
     }
-    firstUnused += 1
   }
   
   /// Removes the elements in the given subrange.
   mutating func remove(subrange: Range<Int>) {
-    var lo = subrange.startIndex
-    var hi = subrange.endIndex
-    
-    // This leaves duplicates of still to-be-used arguments in the unused
-    // portion of the _elements array.
-    while lo > firstUnused {
-      hi -= 1
-      lo -= 1
-      _elements[hi] = _elements[lo]
+    for position in subrange {
+      remove(at: position)
     }
-    firstUnused += subrange.count
   }
   
   /// Removes the element(s) at the given `Index`.
@@ -436,41 +529,35 @@ extension SplitArguments {
   /// will have the same `inputIndex` but different `subIndex`. When either of the short ones
   /// is removed, that will remove the _long with short dash_ as well. Likewise, if the
   /// _long with short dash_ is removed, that will remove both of the _short_ elements.
+  ///
+  /// The elements for a pack are the _long with short dash_ element followed
+  /// by one _short_ element per character, in order, so removing a _short_
+  /// element doesn't need to search the pack.
   mutating func remove(at position: Index) {
-    guard !isEmpty else { return }
-    
-    // Find the first element at the given input index. Since `elements` is
-    // always sorted by input index, we can leave this method if we see a
-    // higher value than `position`.
-    var start = elements.startIndex
-    while start < elements.endIndex {
-      if elements[start].index.inputIndex == position.inputIndex { break }
-      if elements[start].index.inputIndex > position.inputIndex { return }
-      start += 1
-    }
-    guard start < elements.endIndex else { return }
+    let range = positions(for: position.inputIndex)
+    guard !range.isEmpty else { return }
     
     if case .complete = position.subIndex {
       // When removing a `.complete` position, we need to remove both the
       // complete element and any sub-elements with the same input index.
-      
-      // Remove up to the first element where the input index doesn't match.
-      let end = elements[start...].firstIndex(where: { $0.index.inputIndex != position.inputIndex })
-        ?? elements.endIndex
-
-      remove(subrange: start..<end)
+      remove(subrange: range)
     } else {
       // When removing a `.sub` (i.e. non-`.complete`) position, we need to
       // also remove the `.complete` position, if it exists. Since `.complete`
       // positions always come before sub-positions, if one exists it  will be
-      // the position found as `start`.
-      if elements[start].index.subIndex == .complete {
-        remove(at: start)
-        start += 1
+      // the first position for this input index.
+      var subStart = range.lowerBound
+      if _elements[range.lowerBound].index.subIndex == .complete {
+        remove(at: range.lowerBound)
+        subStart += 1
       }
       
-      if let sub = elements[start...].firstIndex(where: { $0.index == position }) {
-        remove(at: sub)
+      guard case .sub(let sub) = position.subIndex else { return }
+      let expected = subStart + sub
+      if range.contains(expected), _elements[expected].index == position {
+        remove(at: expected)
+      } else if let other = range.first(where: { _elements[$0].index == position }) {
+        remove(at: other)
       }
     }
   }
@@ -490,11 +577,11 @@ extension SplitArguments {
   }
   
   func coalescedExtraElements() -> [(InputOrigin, String)] {
-    let completeIndexes: [InputIndex] = elements
+    let completeIndexes: Set<InputIndex> = Set(elements
       .compactMap {
         guard case .complete = $0.index.subIndex else { return nil }
         return $0.index.inputIndex
-    }
+    })
     
     // Now return all elements that are either:
     // 1) `.complete`
@@ -527,6 +614,10 @@ extension SplitArguments {
 }
 
 func parseIndividualArg(_ arg: String, at position: Int) throws -> [SplitArguments.Element] {
+  if let elements = try parseASCIIArg(arg, at: position) {
+    return elements
+  }
+  
   let index = SplitArguments.Index(inputIndex: .init(rawValue: position))
   if let nonDashIdx = arg.firstIndex(where: { $0 != "-" }) {
     let dashCount = arg.distance(from: arg.startIndex, to: nonDashIdx)
@@ -539,23 +630,17 @@ func parseIndividualArg(_ arg: String, at position: Int) throws -> [SplitArgumen
       let parsed = try ParsedArgument(longArgWithSingleDashRemainder: remainder)
       
       // Short options:
-      let parts = parsed.subarguments
-      switch parts.count {
-      case 0:
-        // This is a '-name=value' style argument
+      guard parsed.isShortOptionPack else {
+        // This is a '-name=value' or a single short '-n' style argument
         return [.option(parsed, index: index)]
-      case 1:
-        // This is a single short '-n' style argument
-        return [.option(.name(.short(remainder.first!)), index: index)]
-      default:
-        var result: [SplitArguments.Element] = [.option(parsed, index: index)]
-        for (sub, a) in parts {
-          var i = index
-          i.subIndex = .sub(sub)
-          result.append(.option(a, index: i))
-        }
-        return result
       }
+      var result: [SplitArguments.Element] = [.option(parsed, index: index)]
+      for (sub, c) in remainder.enumerated() {
+        var i = index
+        i.subIndex = .sub(sub)
+        result.append(.option(.name(.short(c)), index: i))
+      }
+      return result
     case 2:
       return [.option(ParsedArgument(arg), index: index)]
     default:
@@ -577,6 +662,102 @@ func parseIndividualArg(_ arg: String, at position: Int) throws -> [SplitArgumen
   }
 }
 
+/// Splits `arg` by scanning its UTF-8 code units, without breaking it into
+/// characters.
+///
+/// Returns `nil` if the name portion of an option isn't entirely ASCII, or
+/// if the `=` that separates an attached value is part of a larger
+/// character. In those cases, `parseIndividualArg(_:at:)` falls back to
+/// splitting the argument by character; otherwise, the result is the same.
+private func parseASCIIArg(_ arg: String, at position: Int) throws -> [SplitArguments.Element]? {
+  let index = SplitArguments.Index(inputIndex: .init(rawValue: position))
+  let utf8 = arg.utf8
+  let dash = UInt8(ascii: "-")
+  
+  var nameStart = utf8.startIndex
+  var dashCount = 0
+  while nameStart != utf8.endIndex && utf8[nameStart] == dash {
+    dashCount += 1
+    utf8.formIndex(after: &nameStart)
+  }
+  
+  guard nameStart != utf8.endIndex else {
+    // All dashes
+    switch dashCount {
+    case 0, 1:
+      // Empty string or single dash
+      return [.value(arg, index: index)]
+    case 2:
+      // We found the 1st "--". All the remaining are positional.
+      return [.terminator(index: index)]
+    default:
+      throw ParserError.invalidOption(arg)
+    }
+  }
+  
+  // A value can start with any character, since it isn't split any further.
+  if dashCount == 0 {
+    return [.value(arg, index: index)]
+  }
+  
+  // Find the end of the name, bailing out at the first non-ASCII byte, or
+  // at a carriage return, which is one character together with a following
+  // newline.
+  var nameEnd = nameStart
+  while nameEnd != utf8.endIndex && utf8[nameEnd] != UInt8(ascii: "=") {
+    guard utf8[nameEnd] < 0x80 && utf8[nameEnd] != UInt8(ascii: "\r") else { return nil }
+    utf8.formIndex(after: &nameEnd)
+  }
+  
+  let name = arg[nameStart..<nameEnd]
+  var value: Substring?
+  if nameEnd != utf8.endIndex {
+    // A combining mark after the `=` would make it part of a different
+    // character, so check that the `=` stands on its own.
+    guard arg[nameEnd...].first == "=" else { return nil }
+    value = arg[utf8.index(after: nameEnd)...]
+  }
+  
+  switch dashCount {
+  case 1:
+    if let value = value {
+      // This is a '-name=value' style argument
+      guard !name.isEmpty else {
+        throw ParserError.invalidOption(arg)
+      }
+      let parsedName = name.utf8.count == 1
+        ? Name.short(name.first!)
+        : Name.longWithSingleDash(String(name))
+      return [.option(.nameWithValue(parsedName, value), index: index)]
+    }
+    
+    if name.utf8.count == 1 {
+      // This is a single short '-n' style argument
+      return [.option(.name(.short(name.first!)), index: index)]
+    }
+    
+    // Long option, followed by each of its characters as short options
+    var result: [SplitArguments.Element] = [.option(.name(.longWithSingleDash(String(name))), index: index)]
+    result.reserveCapacity(name.utf8.count + 1)
+    for (sub, byte) in name.utf8.enumerated() {
+      var i = index
+      i.subIndex = .sub(sub)
+      result.append(.option(.name(.short(Character(Unicode.Scalar(byte)))), index: i))
+    }
+    return result
+  
+  case 2:
+    let parsedName = Name.long(String(name))
+    if let value = value, !value.isEmpty {
+      return [.option(.nameWithValue(parsedName, value), index: index)]
+    }
+    return [.option(.name(parsedName), index: index)]
+  
+  default:
+    throw ParserError.invalidOption(arg)
+  }
+}
+
 extension SplitArguments {
   /// Parses the given input into an array of `Element`.
   ///
@@ -586,12 +767,14 @@ extension SplitArguments {
     
     var position = 0
     var args = arguments[...]
+    _inputPositions.reserveCapacity(arguments.count)
     argLoop: while let arg = args.popFirst() {
       defer {
         position += 1
       }
       
       let parsedElements = try parseIndividualArg(arg, at: position)
+      _inputPositions.append(_elements.count)
       _elements.append(contentsOf: parsedElements)
       if parsedElements.first!.isTerminator {
         break
@@ -600,9 +783,13 @@ extension SplitArguments {
     
     for arg in args {
       let i = Index(inputIndex: InputIndex(rawValue: position))
+      _inputPositions.append(_elements.count)
       _elements.append(.value(arg, index: i))
       position += 1
     }
+    
+    _isUsed = Array(repeating: false, count: _elements.count)
+    unusedCount = _elements.count
   }
 }
 
@@ -629,8 +816,7 @@ private extension ParsedArgument {
         throw ParserError.invalidOption(makeName(remainder).synopsisString)
       }
       let after = remainder.index(after: equalIdx)
-      let value = String(remainder[after..<remainder.endIndex])
-      self = .nameWithValue(makeName(name), value)
+      self = .nameWithValue(makeName(name), remainder[after..<remainder.endIndex])
     } else {
       self = .name(makeName(remainder))
     }
@@ -0,0 +1,358 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+extension HelpInfo {
+  /// The version of the compact help dump format that this library writes
+  /// and reads.
+  ///
+  /// The version changes whenever a change to the format would make an
+  /// existing reader misinterpret a dump.
+  public static let compactSerializationVersion = 1
+
+  /// Creates the help information for a command from its compact help dump,
+  /// the output of `--dump-help-compact`.
+  ///
+  /// A compact dump is a single line of JSON, with the same structure as the
+  /// output of `--dump-help` and an additional top-level
+  /// `serializationVersion` field. Keys that this version of the library
+  /// doesn't know about are ignored.
+  ///
+  /// - Parameter compactDump: The compact help dump to read.
+  /// - Throws: An error if `compactDump` isn't valid JSON, doesn't describe
+  ///   a command, or has a different `serializationVersion`.
+  public init(compactDump: String) throws {
+    var compactDump = compactDump
+    self = try compactDump.withUTF8 { buffer in
+      var reader = JSONValueReader(UnsafeRawBufferPointer(buffer))
+      return try reader.readCompactHelpDump()
+    }
+  }
+
+  /// Returns this help information as a compact help dump.
+  func compactDump() -> String {
+    var writer = CompactHelpDumpWriter()
+    writer.write(self, serializationVersion: HelpInfo.compactSerializationVersion)
+    return String(decoding: writer.bytes, as: UTF8.self)
+  }
+}
+
+// MARK: - Writing
+
+/// Writes help information as a single line of JSON, directly into a byte
+/// buffer.
+///
+/// Keys are written in declaration order, and `nil` properties are left
+/// out, like the synthesized `Encodable` conformances do.
+fileprivate struct CompactHelpDumpWriter {
+  var bytes: [UInt8] = []
+
+  init() {
+    bytes.reserveCapacity(4096)
+  }
+
+  mutating func write(_ info: HelpInfo, serializationVersion: Int? = nil) {
+    var object = ObjectWriter()
+    if let version = serializationVersion {
+      object.key("serializationVersion", &self)
+      bytes.append(contentsOf: String(version).utf8)
+    }
+    object.key("command", &self)
+    write(info.command)
+    if let subcommands = info.subcommands {
+      object.key("subcommands", &self)
+      writeArray(subcommands) { $0.write($1) }
+    }
+    if let arguments = info.arguments {
+      object.key("arguments", &self)
+      writeArray(arguments) { $0.write($1) }
+    }
+    if let options = info.options {
+      object.key("options", &self)
+      writeArray(options) { $0.write($1) }
+    }
+    bytes.append(UInt8(ascii: "}"))
+  }
+
+  mutating func write(_ info: CommandInfo) {
+    var object = ObjectWriter()
+    if let name = info.name {
+      object.key("name", &self)
+      writeArray(name) { $0.write($1) }
+    }
+    object.key("abstract", &self)
+    write(info.abstract)
+    object.key("discussion", &self)
+    write(info.discussion)
+    if let isDefault = info.isDefault {
+      object.key("isDefault", &self)
+      write(isDefault)
+    }
+    bytes.append(UInt8(ascii: "}"))
+  }
+
+  mutating func write(_ info: ArgumentInfo) {
+    var object = ObjectWriter()
+    if let name = info.name {
+      object.key("name", &self)
+      writeArray(name) { $0.write($1) }
+    }
+    object.key("abstract", &self)
+    write(info.abstract)
+    object.key("discussion", &self)
+    write(info.discussion)
+    if let isRequired = info.isRequired {
+      object.key("isRequired", &self)
+      write(isRequired)
+    }
+    if let defaultValue = info.defaultValue {
+      object.key("defaultValue", &self)
+      write(defaultValue)
+    }
+    if let valueName = info.valueName {
+      object.key("valueName", &self)
+      write(valueName)
+    }
+    bytes.append(UInt8(ascii: "}"))
+  }
+
+  mutating func writeArray<T>(_ elements: [T], _ writeElement: (inout CompactHelpDumpWriter, T) -> Void) {
+    bytes.append(UInt8(ascii: "["))
+    for (i, element) in elements.enumerated() {
+      if i > 0 { bytes.append(UInt8(ascii: ",")) }
+      writeElement(&self, element)
+    }
+    bytes.append(UInt8(ascii: "]"))
+  }
+
+  mutating func write(_ value: Bool) {
+    bytes.append(contentsOf: (value ? "true" : "false").utf8)
+  }
+
+  mutating func write(_ string: String) {
+    bytes.append(UInt8(ascii: "\""))
+    for byte in string.utf8 {
+      switch byte {
+      case UInt8(ascii: "\""), UInt8(ascii: "\\"):
+        bytes.append(UInt8(ascii: "\\"))
+        bytes.append(byte)
+      case UInt8(ascii: "\n"):
+        bytes.append(contentsOf: #"\n"#.utf8)
+      case UInt8(ascii: "\r"):
+        bytes.append(contentsOf: #"\r"#.utf8)
+      case UInt8(ascii: "\t"):
+        bytes.append(contentsOf: #"\t"#.utf8)
+      case 0..<0x20:
+        let hexDigits = Array("0123456789abcdef".utf8)
+        bytes.append(contentsOf: #"\u00"#.utf8)
+        bytes.append(hexDigits[Int(byte >> 4)])
+        bytes.append(hexDigits[Int(byte & 0xF)])
+      default:
+        bytes.append(byte)
+      }
+    }
+    bytes.append(UInt8(ascii: "\""))
+  }
+
+  /// Tracks whether a separator is needed before the next key of an object.
+  struct ObjectWriter {
+    private var isFirst = true
+
+    mutating func key(_ key: String, _ writer: inout CompactHelpDumpWriter) {
+      writer.bytes.append(isFirst ? UInt8(ascii: "{") : UInt8(ascii: ","))
+      isFirst = false
+      writer.write(key)
+      writer.bytes.append(UInt8(ascii: ":"))
+    }
+  }
+}
+
+// MARK: - Reading
+
+extension JSONValueReader {
+  /// Reads a complete compact help dump.
+  mutating func readCompactHelpDump() throws -> HelpInfo {
+    var version: Int?
+    let info = try readHelpInfo { reader in
+      version = try reader.readInt()
+    }
+
+    guard let serializationVersion = version else {
+      throw error("Missing serializationVersion")
+    }
+    guard serializationVersion == HelpInfo.compactSerializationVersion else {
+      throw error("Unsupported serializationVersion \(serializationVersion)")
+    }
+
+    skipWhitespace()
+    guard position == bytes.count else {
+      throw error("Unexpected content after the top-level object")
+    }
+    return info
+  }
+
+  /// Reads a `HelpInfo` object, passing the `serializationVersion` value, if
+  /// there is one, to `readVersion`.
+  private mutating func readHelpInfo(
+    readingVersionWith readVersion: ((inout JSONValueReader) throws -> Void)? = nil
+  ) throws -> HelpInfo {
+    var command: CommandInfo?
+    var subcommands: [HelpInfo]?
+    var arguments: [ArgumentInfo]?
+    var options: [ArgumentInfo]?
+
+    try readObject { reader, key in
+      switch key {
+      case "serializationVersion" where readVersion != nil:
+        try readVersion!(&reader)
+      case "command":
+        command = try reader.readCommandInfo()
+      case "subcommands":
+        subcommands = try reader.readArray { try $0.readHelpInfo() }
+      case "arguments":
+        arguments = try reader.readArray { try $0.readArgumentInfo() }
+      case "options":
+        options = try reader.readArray { try $0.readArgumentInfo() }
+      default:
+        try reader.skipValue()
+      }
+    }
+
+    guard let commandInfo = command else { throw error("Missing command") }
+    return HelpInfo(command: commandInfo, subcommands: subcommands, arguments: arguments, options: options)
+  }
+
+  private mutating func readCommandInfo() throws -> CommandInfo {
+    var name: [String]?
+    var abstract: String?
+    var discussion: String?
+    var isDefault: Bool?
+
+    try readObject { reader, key in
+      switch key {
+      case "name": name = try reader.readArray { try $0.readString() }
+      case "abstract": abstract = try reader.readString()
+      case "discussion": discussion = try reader.readString()
+      case "isDefault": isDefault = try reader.readOptional { try $0.readBool() }
+      default: try reader.skipValue()
+      }
+    }
+
+    guard let abstractValue = abstract, let discussionValue = discussion else {
+      throw error("Missing abstract or discussion")
+    }
+    return CommandInfo(name: name, abstract: abstractValue, discussion: discussionValue, isDefault: isDefault)
+  }
+
+  private mutating func readArgumentInfo() throws -> ArgumentInfo {
+    var name: [String]?
+    var abstract: String?
+    var discussion: String?
+    var isRequired: Bool?
+    var defaultValue: String?
+    var valueName: String?
+
+    try readObject { reader, key in
+      switch key {
+      case "name": name = try reader.readArray { try $0.readString() }
+      case "abstract": abstract = try reader.readString()
+      case "discussion": discussion = try reader.readString()
+      case "isRequired": isRequired = try reader.readOptional { try $0.readBool() }
+      case "defaultValue": defaultValue = try reader.readOptional { try $0.readString() }
+      case "valueName": valueName = try reader.readOptional { try $0.readString() }
+      default: try reader.skipValue()
+      }
+    }
+
+    guard let abstractValue = abstract, let discussionValue = discussion else {
+      throw error("Missing abstract or discussion")
+    }
+    return ArgumentInfo(name: name, abstract: abstractValue, discussion: discussionValue, isRequired: isRequired, defaultValue: defaultValue, valueName: valueName)
+  }
+
+  // MARK: Values
+
+  /// Reads an object, calling `readValue` with each key after positioning
+  /// the reader at that key's value.
+  private mutating func readObject(_ readValue: (inout JSONValueReader, String) throws -> Void) throws {
+    try expect(UInt8(ascii: "{"))
+    guard !consume(UInt8(ascii: "}")) else { return }
+    repeat {
+      skipWhitespace()
+      let key = try readString()
+      try expect(UInt8(ascii: ":"))
+      skipWhitespace()
+      try readValue(&self, key)
+    } while consume(UInt8(ascii: ","))
+    try expect(UInt8(ascii: "}"))
+  }
+
+  /// Reads an array, or `null` as `nil`.
+  private mutating func readArray<T>(_ readElement: (inout JSONValueReader) throws -> T) throws -> [T]? {
+    try readOptional { reader in
+      var result: [T] = []
+      try reader.expect(UInt8(ascii: "["))
+      guard !reader.consume(UInt8(ascii: "]")) else { return result }
+      repeat {
+        reader.skipWhitespace()
+        result.append(try readElement(&reader))
+      } while reader.consume(UInt8(ascii: ","))
+      try reader.expect(UInt8(ascii: "]"))
+      return result
+    }
+  }
+
+  /// Reads a value with `readValue`, or `null` as `nil`.
+  private mutating func readOptional<T>(_ readValue: (inout JSONValueReader) throws -> T) throws -> T? {
+    skipWhitespace()
+    if position < bytes.count, bytes[position] == UInt8(ascii: "n") {
+      try expectWord("null")
+      return nil
+    }
+    return try readValue(&self)
+  }
+
+  private mutating func readBool() throws -> Bool {
+    if position < bytes.count, bytes[position] == UInt8(ascii: "t") {
+      try expectWord("true")
+      return true
+    }
+    try expectWord("false")
+    return false
+  }
+
+  private mutating func readInt() throws -> Int {
+    guard let value = Int(readNumber()) else { throw error("Expected an integer") }
+    return value
+  }
+
+  /// Skips over a value of any kind, including nested objects and arrays.
+  private mutating func skipValue() throws {
+    skipWhitespace()
+    guard position < bytes.count else { throw error("Expected a value") }
+
+    switch bytes[position] {
+    case UInt8(ascii: "{"):
+      try readObject { reader, _ in try reader.skipValue() }
+    case UInt8(ascii: "["):
+      _ = try readArray { try $0.skipValue() }
+    case UInt8(ascii: "\""):
+      _ = try readString()
+    case UInt8(ascii: "t"), UInt8(ascii: "f"):
+      _ = try readBool()
+    case UInt8(ascii: "n"):
+      try expectWord("null")
+    case UInt8(ascii: "-"), UInt8(ascii: "0")...UInt8(ascii: "9"):
+      _ = readNumber()
+    default:
+      throw error("Expected a value")
+    }
+  }
+}
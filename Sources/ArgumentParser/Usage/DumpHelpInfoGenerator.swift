@@ -18,10 +18,12 @@ public struct CommandInfo: Codable, Equatable {
     self.isDefault = isDefault
   }
 
-  var name: [String]?
-  var abstract: String
-  var discussion: String
-  var isDefault: Bool?
+  /// The full name of the command, or the name of a subcommand.
+  public internal(set) var name: [String]?
+  public internal(set) var abstract: String
+  public internal(set) var discussion: String
+  /// Whether this is the default subcommand of its parent.
+  public internal(set) var isDefault: Bool?
 }
 
 public struct ArgumentInfo: Codable, Hashable, Equatable {
@@ -35,16 +37,16 @@ public struct ArgumentInfo: Codable, Hashable, Equatable {
   }
   
   // Only for options and commands
-  var name: [String]?
+  public internal(set) var name: [String]?
   
   // Shared properties
-  var abstract: String
-  var discussion: String
+  public internal(set) var abstract: String
+  public internal(set) var discussion: String
   
   // Used only for arguments and options
-  var isRequired: Bool?
-  var defaultValue: String?
-  var valueName: String?
+  public internal(set) var isRequired: Bool?
+  public internal(set) var defaultValue: String?
+  public internal(set) var valueName: String?
 }
 
 public struct HelpInfo: Codable, Equatable {
@@ -55,26 +57,25 @@ public struct HelpInfo: Codable, Equatable {
       self.options = options
     }
     
-    var command : CommandInfo
-    var subcommands: [HelpInfo]?
-    var arguments: [ArgumentInfo]?
-    var options: [ArgumentInfo]?
+    public internal(set) var command : CommandInfo
+    public internal(set) var subcommands: [HelpInfo]?
+    public internal(set) var arguments: [ArgumentInfo]?
+    public internal(set) var options: [ArgumentInfo]?
 }
 
 internal struct DumpHelpInfoGenerator {
   var helpInfo: HelpInfo
   
   init(commandStack: [ParsableCommand.Type]) {
-    var toolName = commandStack.map { $0._commandName }.joined(separator: " ")
-    if let superName = commandStack.first!.configuration._superCommandName {
-      toolName = "\(superName) \(toolName)"
-    }
-    let toolAbstract = commandStack.last!.configuration.abstract
-    let toolDiscussion = commandStack.last!.configuration.discussion
-    self.helpInfo = HelpInfo(command: CommandInfo(name: [toolName], abstract: toolAbstract, discussion: toolDiscussion),
-                             subcommands: DumpHelpInfoGenerator.getSubcommandNames(commandStack: commandStack),
-                             arguments: DumpHelpInfoGenerator.getArgumentInfo(commandStack: commandStack),
-                             options: DumpHelpInfoGenerator.getOptionInfo(commandStack: commandStack))
+    self.init(model: HelpModel.model(for: commandStack))
+  }
+  
+  init(model: HelpModel) {
+    let (arguments, options) = DumpHelpInfoGenerator.getArgumentAndOptionInfo(model: model)
+    self.helpInfo = HelpInfo(command: CommandInfo(name: [model.toolName], abstract: model.configuration.abstract, discussion: model.configuration.discussion),
+                             subcommands: DumpHelpInfoGenerator.getSubcommandNames(model: model),
+                             arguments: arguments,
+                             options: options)
   }
   
   init(_ type: ParsableArguments.Type) {
@@ -82,29 +83,33 @@ internal struct DumpHelpInfoGenerator {
   }
   
   
-  static func getSubcommandNames(commandStack: [ParsableCommand.Type]) -> [HelpInfo]? {
-    let superCommand = commandStack.first!
-    let defaultSubcommand = commandStack.last!.configuration.defaultSubcommand
-    let subcommandsToShow = commandStack.last!.configuration.subcommands
+  static func getSubcommandNames(model: HelpModel) -> [HelpInfo]? {
+    let superCommand = model.commandStack.first!
+    let defaultSubcommand = model.configuration.defaultSubcommand
+    let subcommandsToShow = model.configuration.subcommands
       .filter { $0.configuration.shouldDisplay }
     
     guard !subcommandsToShow.isEmpty else { return nil }
     
     return subcommandsToShow
-      .compactMap { HelpInfo(command: CommandInfo(name: [$0._commandName], abstract: $0.configuration.abstract, discussion: $0.configuration.discussion, isDefault: $0 == defaultSubcommand),
-                             subcommands: getSubcommandNames(commandStack: [superCommand, $0]),
-                             arguments: getArgumentInfo(commandStack: [superCommand, $0]),
-                             options: getOptionInfo(commandStack: [superCommand, $0]))
-        
+      .map { subcommand in
+        let model = HelpModel.model(for: [superCommand, subcommand])
+        let (arguments, options) = getArgumentAndOptionInfo(model: model)
+        return HelpInfo(command: CommandInfo(name: [subcommand._commandName], abstract: model.configuration.abstract, discussion: model.configuration.discussion, isDefault: subcommand == defaultSubcommand),
+                        subcommands: getSubcommandNames(model: model),
+                        arguments: arguments,
+                        options: options)
       }
   }
   
-  static func getHelpInfo(commandStack: [ParsableCommand.Type], isPositional: Bool) -> [ArgumentInfo] {
-    guard let commandType = commandStack.last else { return [] }
-    let args = Array(ArgumentSet(commandType, creatingHelp: true))
+  /// Returns the information for every displayed argument of the last
+  /// command in the model's stack, in order, along with whether each one is
+  /// positional.
+  static func getHelpInfo(model: HelpModel) -> [(isPositional: Bool, info: ArgumentInfo)] {
+    let args = Array(model.helpArguments)
     
     var i = 0
-    return args.compactMap { arg in
+    return args.compactMap { arg -> (isPositional: Bool, info: ArgumentInfo)? in
       defer { i += 1 }
       guard arg.help.shouldDisplay != false else { return nil }
       let description: String
@@ -134,14 +139,29 @@ internal struct DumpHelpInfoGenerator {
         if case .named(let names) = arg.kind {
             name = arg.isPositional ? nil : names.map{ $0.synopsisString }.compactMap { String(describing: $0) }
         }
-      guard arg.isPositional == isPositional else { return nil }
-      return ArgumentInfo(name: name, abstract: description, discussion: arg.help.discussion, isRequired: !arg.help.options.contains(.isOptional), defaultValue: arg.help.defaultValue, valueName: arg.valueName)
+      return (arg.isPositional, ArgumentInfo(name: name, abstract: description, discussion: arg.help.discussion, isRequired: !arg.help.options.contains(.isOptional), defaultValue: arg.help.defaultValue, valueName: arg.valueName))
+    }
+  }
+  
+  /// Returns the positional argument and option information for the last
+  /// command in the model's stack, from a single pass over its arguments.
+  static func getArgumentAndOptionInfo(model: HelpModel) -> (arguments: [ArgumentInfo]?, options: [ArgumentInfo]?) {
+    var positionals: [ArgumentInfo] = []
+    var options: [ArgumentInfo] = []
+    for (isPositional, info) in getHelpInfo(model: model) {
+      if isPositional {
+        positionals.append(info)
+      } else {
+        options.append(info)
+      }
     }
+    return (
+      uniqueArgumentInfo(positionals),
+      uniqueOptionInfo(options, commandStack: model.commandStack))
   }
   
-  static func getArgumentInfo(commandStack: [ParsableCommand.Type]) -> [ArgumentInfo]? {
+  private static func uniqueArgumentInfo(_ helpInfo: [ArgumentInfo]) -> [ArgumentInfo]? {
     var alreadySeenElements = Set<ArgumentInfo>()
-    let helpInfo = DumpHelpInfoGenerator.getHelpInfo(commandStack: commandStack, isPositional: true)
     
     let helpInfoArray = helpInfo
       .filter { !alreadySeenElements.contains($0) }
@@ -153,9 +173,8 @@ internal struct DumpHelpInfoGenerator {
     return helpInfoArray.count > 0 ? helpInfoArray : nil
   }
   
-  static func getOptionInfo(commandStack: [ParsableCommand.Type]) -> [ArgumentInfo]? {
+  private static func uniqueOptionInfo(_ helpInfo: [ArgumentInfo], commandStack: [ParsableCommand.Type]) -> [ArgumentInfo]? {
     var alreadySeenElements = Set<ArgumentInfo>()
-    let helpInfo = DumpHelpInfoGenerator.getHelpInfo(commandStack: commandStack, isPositional: false)
     
     var helpInfoArray = helpInfo
       .filter { !alreadySeenElements.contains($0) }
@@ -179,6 +198,16 @@ internal struct DumpHelpInfoGenerator {
     return helpInfoArray.count > 0 ? helpInfoArray : nil
   }
   
+  /// Returns the JSON help dump for `commandStack`.
+  static func rendered(commandStack: [ParsableCommand.Type]) -> String {
+    DumpHelpInfoGenerator(commandStack: commandStack).rendered()
+  }
+  
+  /// Returns the compact help dump for `commandStack`.
+  static func renderedCompact(commandStack: [ParsableCommand.Type]) -> String {
+    DumpHelpInfoGenerator(commandStack: commandStack).helpInfo.compactDump()
+  }
+  
   func rendered() -> String {
     let encoder = JSONEncoder()
     encoder.outputFormatting = .prettyPrinted
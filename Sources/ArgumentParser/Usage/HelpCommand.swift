@@ -35,7 +35,7 @@ struct HelpCommand: ParsableCommand {
   }
   
   func generateHelp() -> String {
-    return HelpGenerator(commandStack: commandStack).rendered()
+    return HelpGenerator.rendered(commandStack: commandStack)
   }
   
   enum CodingKeys: CodingKey {
@@ -39,19 +39,21 @@ internal struct HelpGenerator {
       
       func rendered(screenWidth: Int) -> String {
         let paddedLabel = self.paddedLabel
-        let wrappedAbstract = self.abstract
-          .wrapped(to: screenWidth, wrappingIndent: HelpGenerator.labelColumnWidth)
         let wrappedDiscussion = self.discussion.isEmpty
           ? ""
           : self.discussion.wrapped(to: screenWidth, wrappingIndent: HelpGenerator.helpIndent * 4) + "\n"
         let renderedAbstract: String = {
           guard !abstract.isEmpty else { return "" }
           if paddedLabel.count < HelpGenerator.labelColumnWidth {
-            // Render after padded label.
-            return String(wrappedAbstract.dropFirst(paddedLabel.count))
+            // Render after padded label, indenting only the rest of the way
+            // to the abstract column.
+            return abstract.wrapped(
+              to: screenWidth,
+              wrappingIndent: HelpGenerator.labelColumnWidth,
+              firstLineIndent: HelpGenerator.labelColumnWidth - paddedLabel.count)
           } else {
             // Render in a new line.
-            return "\n" + wrappedAbstract
+            return "\n" + abstract.wrapped(to: screenWidth, wrappingIndent: HelpGenerator.labelColumnWidth)
           }
         }()
         return paddedLabel
@@ -83,11 +85,20 @@ internal struct HelpGenerator {
     var isSubcommands: Bool = false
     
     func rendered(screenWidth: Int) -> String {
-      guard !elements.isEmpty else { return "" }
+      var result = ""
+      render(screenWidth: screenWidth, to: &result)
+      return result
+    }
+    
+    /// Writes this section to `output` one element at a time, or writes
+    /// nothing if the section has no elements.
+    func render<Target: TextOutputStream>(screenWidth: Int, to output: inout Target) {
+      guard !elements.isEmpty else { return }
       
-      let renderedElements = elements.map { $0.rendered(screenWidth: screenWidth) }.joined()
-      return "\(String(describing: header).uppercased()):\n"
-        + renderedElements
+      output.write("\(String(describing: header).uppercased()):\n")
+      for element in elements {
+        output.write(element.rendered(screenWidth: screenWidth))
+      }
     }
   }
   
@@ -103,35 +114,29 @@ internal struct HelpGenerator {
   var discussionSections: [DiscussionSection]
   
   init(commandStack: [ParsableCommand.Type]) {
-    guard let currentCommand = commandStack.last else {
-      fatalError()
-    }
-    
-    let currentArgSet = ArgumentSet(currentCommand)
-    self.commandStack = commandStack
-
-    // Build the tool name and subcommand name from the command configuration
-    var toolName = commandStack.map { $0._commandName }.joined(separator: " ")
-    if let superName = commandStack.first!.configuration._superCommandName {
-      toolName = "\(superName) \(toolName)"
-    }
+    self.init(model: HelpModel.model(for: commandStack))
+  }
+  
+  init(model: HelpModel) {
+    let configuration = model.configuration
+    self.commandStack = model.commandStack
 
-    var usageString = UsageGenerator(toolName: toolName, definition: [currentArgSet]).synopsis
-    if !currentCommand.configuration.subcommands.isEmpty {
+    var usageString = UsageGenerator(toolName: model.toolName, definition: [model.arguments]).synopsis
+    if !configuration.subcommands.isEmpty {
       if usageString.last != " " { usageString += " " }
       usageString += "<subcommand>"
     }
     
-    self.abstract = currentCommand.configuration.abstract
-    if !currentCommand.configuration.discussion.isEmpty {
+    self.abstract = configuration.abstract
+    if !configuration.discussion.isEmpty {
       if !self.abstract.isEmpty {
         self.abstract += "\n"
       }
-      self.abstract += "\n\(currentCommand.configuration.discussion)"
+      self.abstract += "\n\(configuration.discussion)"
     }
     
     self.usage = Usage(components: [usageString])
-    self.sections = HelpGenerator.generateSections(commandStack: commandStack)
+    self.sections = HelpGenerator.generateSections(model: model)
     self.discussionSections = []
   }
   
@@ -139,15 +144,13 @@ internal struct HelpGenerator {
     self.init(commandStack: [type.asCommand])
   }
 
-  static func generateSections(commandStack: [ParsableCommand.Type]) -> [Section] {
-    guard !commandStack.isEmpty else { return [] }
-    
+  static func generateSections(model: HelpModel) -> [Section] {
     var positionalElements: [Section.Element] = []
     var optionElements: [Section.Element] = []
 
     /// Start with a full slice of the ArgumentSet so we can peel off one or
     /// more elements at a time.
-    var args = commandStack.argumentsForHelp()[...]
+    var args = model.argumentsForHelp[...]
     
     while let arg = args.popFirst() {
       guard arg.help.shouldDisplay else { continue }
@@ -202,7 +205,7 @@ internal struct HelpGenerator {
       }
     }
     
-    let configuration = commandStack.last!.configuration
+    let configuration = model.configuration
     let subcommandElements: [Section.Element] =
       configuration.subcommands.compactMap { command in
         guard command.configuration.shouldDisplay else { return nil }
@@ -234,16 +237,35 @@ internal struct HelpGenerator {
   }
   
   func rendered(screenWidth: Int? = nil) -> String {
+    var result = ""
+    render(screenWidth: screenWidth, to: &result)
+    return result
+  }
+  
+  /// Writes the help screen to `output` as each part is rendered, so that
+  /// the full text is never held in memory at once.
+  func render<Target: TextOutputStream>(screenWidth: Int? = nil, to output: inout Target) {
+    traced(.help, command: commandStack.traceName) {
+      renderSections(screenWidth: screenWidth, to: &output)
+    }
+  }
+  
+  private func renderSections<Target: TextOutputStream>(screenWidth: Int?, to output: inout Target) {
     let screenWidth = screenWidth ?? HelpGenerator.systemScreenWidth
-    let renderedSections = sections
-      .map { $0.rendered(screenWidth: screenWidth) }
-      .filter { !$0.isEmpty }
-      .joined(separator: "\n")
-    let renderedAbstract = abstract.isEmpty
-      ? ""
-      : "OVERVIEW: \(abstract)".wrapped(to: screenWidth) + "\n\n"
+    if !abstract.isEmpty {
+      output.write("OVERVIEW: \(abstract)".wrapped(to: screenWidth) + "\n\n")
+    }
+    output.write("USAGE: \(usage.rendered(screenWidth: screenWidth))\n\n")
+    
+    var isFirstSection = true
+    for section in sections where !section.elements.isEmpty {
+      if !isFirstSection {
+        output.write("\n")
+      }
+      section.render(screenWidth: screenWidth, to: &output)
+      isFirstSection = false
+    }
     
-    var helpSubcommandMessage: String = ""
     if includesSubcommands {
       var names = commandStack.map { $0._commandName }
       if let superName = commandStack.first!.configuration._superCommandName {
@@ -251,18 +273,15 @@ internal struct HelpGenerator {
       }
       names.insert("help", at: 1)
 
-      helpSubcommandMessage = """
-
-          See '\(names.joined(separator: " ")) <subcommand>' for detailed help.
-        """
+      output.write("\n  See '\(names.joined(separator: " ")) <subcommand>' for detailed help.")
     }
-    
-    return """
-    \(renderedAbstract)\
-    USAGE: \(usage.rendered(screenWidth: screenWidth))
-    
-    \(renderedSections)\(helpSubcommandMessage)
-    """
+  }
+}
+
+extension HelpGenerator {
+  /// Returns the help screen for `commandStack`.
+  static func rendered(commandStack: [ParsableCommand.Type], screenWidth: Int? = nil) -> String {
+    HelpGenerator(commandStack: commandStack).rendered(screenWidth: screenWidth)
   }
 }
 
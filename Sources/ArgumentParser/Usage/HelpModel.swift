@@ -0,0 +1,102 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// The information about a command stack that every help format is built
+/// from: the tool name, the last command's configuration, and its arguments.
+///
+/// The help screen, the usage line of an error message, and both help dumps
+/// all read from a single model, so producing any combination of them for a
+/// command stack evaluates the configuration and reflects the arguments
+/// once. The model is built from scratch in every new process, so this
+/// doesn't change the cost of the first help request in a process.
+final class HelpModel {
+  /// The command stack that this model describes.
+  let commandStack: [ParsableCommand.Type]
+
+  /// The name of the tool followed by the names of the commands in the
+  /// stack, as shown in the usage line.
+  let toolName: String
+
+  /// The configuration of the last command in the stack.
+  let configuration: CommandConfiguration
+
+  /// The arguments of the last command in the stack, as it parses them.
+  let arguments: ArgumentSet
+
+  /// The arguments of the last command in the stack that are shown in help,
+  /// not including the help and version flags.
+  let helpArguments: ArgumentSet
+
+  init(commandStack: [ParsableCommand.Type]) {
+    guard let command = commandStack.last else {
+      fatalError()
+    }
+
+    var toolName = commandStack.map { $0._commandName }.joined(separator: " ")
+    if let superName = commandStack.first!.configuration._superCommandName {
+      toolName = "\(superName) \(toolName)"
+    }
+
+    self.commandStack = commandStack
+    self.toolName = toolName
+    self.configuration = command.configuration
+    self.arguments = ArgumentSet(command)
+    self.helpArguments = ArgumentSet(command, creatingHelp: true)
+  }
+
+  /// The arguments shown in help, followed by the version and help flags
+  /// when the stack has them.
+  var argumentsForHelp: ArgumentSet {
+    var arguments = helpArguments
+    commandStack.versionArgumentDefintion().map { arguments.append($0) }
+    commandStack.helpArgumentDefinition().map { arguments.append($0) }
+    return arguments
+  }
+}
+
+// MARK: - Caching
+
+/// A command stack, identified by the types of its commands.
+struct CommandStackKey: Hashable {
+  var commands: [ObjectIdentifier]
+
+  init(_ commandStack: [ParsableCommand.Type]) {
+    self.commands = commandStack.map(ObjectIdentifier.init)
+  }
+}
+
+/// Help models for command stacks whose commands all opt in to
+/// `cachesArgumentDefinitions`.
+///
+/// The cache is keyed only by command types, so its size is bounded by the
+/// program's command tree. Rendered text isn't cached, since it also
+/// depends on the screen width.
+private let helpModelCache = SynchronizedCache<CommandStackKey, HelpModel>()
+
+extension HelpModel {
+  /// Returns the help model for `commandStack`.
+  ///
+  /// A model includes the default values of the stack's arguments, so it's
+  /// only kept for reuse when every command in the stack opts in to
+  /// `cachesArgumentDefinitions`; otherwise a new model is built for each
+  /// request.
+  static func model(for commandStack: [ParsableCommand.Type]) -> HelpModel {
+    let build = {
+      traced(.help, command: commandStack.traceName) {
+        HelpModel(commandStack: commandStack)
+      }
+    }
+    guard commandStack.allSatisfy({ $0.cachesArgumentDefinitions }) else {
+      return build()
+    }
+    return helpModelCache.value(forKey: CommandStackKey(commandStack), orInsert: build)
+  }
+}
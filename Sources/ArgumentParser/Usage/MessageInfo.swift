@@ -13,6 +13,9 @@
 
 enum MessageInfo {
   case help(text: String)
+  /// A help screen that isn't rendered until it's needed, so that it can be
+  /// written directly to an output stream.
+  case helpScreen(commandStack: [ParsableCommand.Type])
   case validation(message: String, usage: String, help: String)
   case other(message: String, exitCode: Int32)
   
@@ -28,12 +31,16 @@ enum MessageInfo {
       // Exit early on built-in requests
       switch e.parserError {
       case .helpRequested:
-        self = .help(text: HelpGenerator(commandStack: e.commandStack).rendered())
+        self = .helpScreen(commandStack: e.commandStack)
         return
       
         
       case .dumpHelpRequested:
-        self = .help(text: DumpHelpInfoGenerator(commandStack: e.commandStack).rendered())
+        self = .help(text: DumpHelpInfoGenerator.rendered(commandStack: e.commandStack))
+        return
+
+      case .compactDumpHelpRequested:
+        self = .help(text: DumpHelpInfoGenerator.renderedCompact(commandStack: e.commandStack))
         return
         
       case .versionRequested:
@@ -54,6 +61,16 @@ enum MessageInfo {
           return
         }
 
+      case .completionShimRequested(let shell):
+        do {
+          let completionsGenerator = try CompletionsGenerator(command: type.asCommand, shellName: shell)
+          self = .help(text: completionsGenerator.generateCompletionShim())
+          return
+        } catch {
+          self.init(error: error, type: type)
+          return
+        }
+
       case .completionScriptCustomResponse(let output):
         self = .help(text: output)
         return
@@ -74,7 +91,10 @@ enum MessageInfo {
       parserError = .userValidationError(error)
     }
     
-    var usage = HelpGenerator(commandStack: commandStack).usageMessage()
+    // The usage line and the error description both read the last command's
+    // arguments from the same help model.
+    let model = HelpModel.model(for: commandStack)
+    var usage = HelpGenerator(model: model).usageMessage()
     
     let commandNames = commandStack.map { $0._commandName }.joined(separator: " ")
     if let helpName = commandStack.getPrimaryHelpName() {
@@ -94,12 +114,12 @@ enum MessageInfo {
           if let command = command {
             commandStack = CommandParser(type.asCommand).commandStack(for: command)
           }
-          self = .help(text: HelpGenerator(commandStack: commandStack).rendered())
+          self = .helpScreen(commandStack: commandStack)
         case .dumpRequest(let command):
           if let command = command {
             commandStack = CommandParser(type.asCommand).commandStack(for: command)
           }
-          self = .help(text: DumpHelpInfoGenerator(commandStack: commandStack).rendered())
+          self = .help(text: DumpHelpInfoGenerator.rendered(commandStack: commandStack))
         case .message(let message):
           self = .help(text: message)
         }
@@ -117,9 +137,9 @@ enum MessageInfo {
     } else if let parserError = parserError {
       let usage: String = {
         guard case ParserError.noArguments = parserError else { return usage }
-        return "\n" + HelpGenerator(commandStack: [type.asCommand]).rendered()
+        return "\n" + HelpGenerator.rendered(commandStack: [type.asCommand])
       }()
-      let argumentSet = ArgumentSet(commandStack.last!)
+      let argumentSet = model.arguments
       let message = argumentSet.errorDescription(error: parserError) ?? ""
       let helpAbstract = argumentSet.helpDescription(error: parserError) ?? ""
       self = .validation(message: message, usage: usage, help: helpAbstract)
@@ -132,6 +152,8 @@ enum MessageInfo {
     switch self {
     case .help(text: let text):
       return text
+    case .helpScreen(commandStack: let commandStack):
+      return HelpGenerator.rendered(commandStack: commandStack)
     case .validation(message: let message, usage: _, help: _):
       return message
     case .other(let message, _):
@@ -143,6 +165,8 @@ enum MessageInfo {
     switch self {
     case .help(text: let text):
       return text
+    case .helpScreen(commandStack: let commandStack):
+      return HelpGenerator.rendered(commandStack: commandStack)
     case .validation(message: let message, usage: let usage, help: let help):
       let helpMessage = help.isEmpty ? "" : "Help:  \(help)\n"
       let errorMessage = message.isEmpty ? "" : "\(args._errorLabel): \(message)\n"
@@ -152,16 +176,33 @@ enum MessageInfo {
     }
   }
   
+  /// Writes the full text of this message to `output`, streaming help
+  /// screens rather than rendering them first.
+  func write<Target: TextOutputStream>(
+    for args: ParsableArguments.Type, to output: inout Target
+  ) {
+    switch self {
+    case .helpScreen(commandStack: let commandStack):
+      HelpGenerator(commandStack: commandStack).render(to: &output)
+      output.write("\n")
+    default:
+      let fullText = self.fullText(for: args)
+      if !fullText.isEmpty {
+        output.write(fullText + "\n")
+      }
+    }
+  }
+  
   var shouldExitCleanly: Bool {
     switch self {
-    case .help: return true
+    case .help, .helpScreen: return true
     case .validation, .other: return false
     }
   }
 
   var exitCode: ExitCode {
     switch self {
-    case .help: return ExitCode.success
+    case .help, .helpScreen: return ExitCode.success
     case .validation: return ExitCode.validationFailure
     case .other(_, let code): return ExitCode(code)
     }
@@ -156,12 +156,16 @@ extension ArgumentSet {
 struct ErrorMessageGenerator {
   var arguments: ArgumentSet
   var error: ParserError
+  
+  /// The largest edit distance at which a known name is suggested for an
+  /// unknown one. An empirically derived magic number.
+  static let maximumSuggestionDistance = 3
 }
 
 extension ErrorMessageGenerator {
   func makeErrorMessage() -> String? {
     switch error {
-    case .helpRequested, .versionRequested, .completionScriptRequested, .completionScriptCustomResponse, .dumpHelpRequested:
+    case .helpRequested, .versionRequested, .completionScriptRequested, .completionShimRequested, .completionScriptCustomResponse, .dumpHelpRequested, .compactDumpHelpRequested:
       return nil
 
     case .unsupportedShell(let shell?):
@@ -181,6 +185,8 @@ extension ErrorMessageGenerator {
       return unexpectedValueForOptionMessage(origin: o, name: n, value: v)
     case .unexpectedExtraValues(let v):
       return unexpectedExtraValuesMessage(values: v)
+    case .unknownSubcommand(_, let name, suggestion: let suggestion):
+      return unknownSubcommandMessage(name: name, suggestion: suggestion)
     case .duplicateExclusiveValues(previous: let previous, duplicate: let duplicate, originalInput: let arguments):
       return duplicateExclusiveValues(previous: previous, duplicate: duplicate, arguments: arguments)
     case .noValue(forKey: let k):
@@ -274,26 +280,16 @@ extension ErrorMessageGenerator {
       return "Unknown option '\(name.synopsisString)'"
     }
     
-    // An empirically derived magic number
-    let SIMILARITY_FLOOR = 4
-
-    let notShort: (Name) -> Bool = { (name: Name) in
-      switch name {
-      case .short: return false
-      case .long: return true
-      case .longWithSingleDash: return true
-      }
-    }
-    let suggestion = arguments
-      .flatMap({ $0.names })
-      .filter({ $0.synopsisString.editDistance(to: name.synopsisString) < SIMILARITY_FLOOR }) // only include close enough suggestion
-      .filter(notShort) // exclude short option suggestions
-      .min(by: { lhs, rhs in // find the suggestion closest to the argument
-        lhs.synopsisString.editDistance(to: name.synopsisString) < rhs.synopsisString.editDistance(to: name.synopsisString)
-      })
+    // Short option names aren't suggested.
+    let candidates = arguments.lazy
+      .flatMap { $0.names }
+      .filter { $0.case != .short }
+      .map { $0.synopsisString }
+    let suggestion = name.synopsisString
+      .closestMatch(in: candidates, maximumDistance: ErrorMessageGenerator.maximumSuggestionDistance)
     
     if let suggestion = suggestion {
-      return "Unknown option '\(name.synopsisString)'. Did you mean '\(suggestion.synopsisString)'?"
+      return "Unknown option '\(name.synopsisString)'. Did you mean '\(suggestion)'?"
     }
     return "Unknown option '\(name.synopsisString)'"
   }
@@ -310,6 +306,10 @@ extension ErrorMessageGenerator {
     return "The option '\(name.synopsisString)' does not take any value, but '\(value)' was specified."
   }
   
+  func unknownSubcommandMessage(name: String, suggestion: String) -> String {
+    "Unknown subcommand '\(name)'. Did you mean '\(suggestion)'?"
+  }
+  
   func unexpectedExtraValuesMessage(values: [(InputOrigin, String)]) -> String? {
     switch values.count {
     case 0:
@@ -324,7 +324,10 @@ extension ErrorMessageGenerator {
   
   func duplicateExclusiveValues(previous: InputOrigin, duplicate: InputOrigin, arguments: [String]) -> String? {
     func elementString(_ origin: InputOrigin, _ arguments: [String]) -> String? {
-      guard case .argumentIndex(let split) = origin.elements.first else { return nil }
+      if let location = origin.valueSourceLocation, !origin.includesArgumentIndex {
+        return location
+      }
+      guard case .argumentIndex(let split) = origin.first else { return nil }
       var argument = "\'\(arguments[split.inputIndex.rawValue])\'"
       if case let .sub(offsetIndex) = split.subIndex {
         let stringIndex = argument.index(argument.startIndex, offsetBy: offsetIndex+2)
@@ -337,7 +340,6 @@ extension ErrorMessageGenerator {
     let dupeString = elementString(duplicate, arguments) ?? "position \(duplicate)"
     let origString = elementString(previous, arguments) ?? "position \(previous)"
 
-    //TODO: review this message once environment values are supported.
     return "Value to be set with \(dupeString) had already been set with \(origString)"
   }
   
@@ -394,7 +396,11 @@ extension ErrorMessageGenerator {
   }
   
   func unableToParseValueMessage(origin: InputOrigin, name: Name?, value: String, key: InputKey, error: Error?) -> String {
-    let valueName = arguments(for: key).first?.valueName
+    // Flags only have invalid values when they come from a value source,
+    // and don't have a value name to show.
+    let valueName = arguments(for: key).first.flatMap {
+      $0.isNullary ? nil : $0.valueName
+    }
     
     // We want to make the "best effort" in producing a custom error message.
     // We favour `LocalizedError.errorDescription` and fall back to
@@ -411,15 +417,19 @@ extension ErrorMessageGenerator {
       }
     }()
     
+    // Values that didn't come from the command line say where they're from.
+    let quotedValue = origin.valueSourceLocation
+      .map { "'\(value)' from \($0)" } ?? "'\(value)'"
+    
     switch (name, valueName) {
     case let (n?, v?):
-      return "The value '\(value)' is invalid for '\(n.synopsisString) <\(v)>'\(customErrorMessage)"
+      return "The value \(quotedValue) is invalid for '\(n.synopsisString) <\(v)>'\(customErrorMessage)"
     case let (_, v?):
-      return "The value '\(value)' is invalid for '<\(v)>'\(customErrorMessage)"
+      return "The value \(quotedValue) is invalid for '<\(v)>'\(customErrorMessage)"
     case let (n?, _):
-      return "The value '\(value)' is invalid for '\(n.synopsisString)'\(customErrorMessage)"
+      return "The value \(quotedValue) is invalid for '\(n.synopsisString)'\(customErrorMessage)"
     case (nil, nil):
-      return "The value '\(value)' is invalid.\(customErrorMessage)"
+      return "The value \(quotedValue) is invalid.\(customErrorMessage)"
     }
   }
 }
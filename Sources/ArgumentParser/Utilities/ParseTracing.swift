@@ -0,0 +1,190 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+@_implementationOnly import Foundation
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#elseif canImport(CRT)
+import CRT
+#endif
+
+/// A phase of the work that the argument parser does to parse a command
+/// line.
+public struct ParsePhase: Hashable, CustomStringConvertible {
+  /// The name of the phase, as it appears in trace output.
+  public var name: String
+
+  /// Building the tree of a root command and its subcommands.
+  public static var commandTree: ParsePhase { ParsePhase(name: "commandTree") }
+
+  /// Reflecting over a type to find its arguments.
+  public static var argumentSet: ParsePhase { ParsePhase(name: "argumentSet") }
+
+  /// Splitting the command-line arguments into options and values.
+  public static var splitArguments: ParsePhase { ParsePhase(name: "splitArguments") }
+
+  /// Matching the split arguments to a command's arguments and converting
+  /// their values.
+  public static var parse: ParsePhase { ParsePhase(name: "parse") }
+
+  /// Decoding a command from its parsed values.
+  public static var decode: ParsePhase { ParsePhase(name: "decode") }
+
+  /// Calling a command's `validate()` method.
+  public static var validate: ParsePhase { ParsePhase(name: "validate") }
+
+  /// Building or rendering a help screen.
+  public static var help: ParsePhase { ParsePhase(name: "help") }
+
+  public var description: String { name }
+}
+
+/// A type that observes the phases of parsing, for measuring the startup
+/// cost of a command-line tool.
+///
+/// Install a tracer by assigning it to `ParseTracing.tracer`. Each phase
+/// reports the command that it's working on, so intervals can be attributed
+/// to each command in the stack. A phase that only runs the first time a
+/// command is used, like `.argumentSet`, isn't reported when its result is
+/// already cached.
+///
+/// `phaseDidBegin` and `phaseDidEnd` are called on the thread doing the
+/// work, in nested pairs, which makes them a good fit for signpost
+/// intervals or for sampling allocator statistics.
+public protocol ParseTracer {
+  /// Called when a phase begins.
+  func phaseDidBegin(_ phase: ParsePhase, command: String)
+
+  /// Called when a phase ends, with its duration in seconds.
+  func phaseDidEnd(_ phase: ParsePhase, command: String, duration: Double)
+}
+
+extension ParseTracer {
+  public func phaseDidBegin(_ phase: ParsePhase, command: String) {}
+}
+
+/// The tracer to notify about the phases of parsing.
+public enum ParseTracing {
+  /// The installed tracer, if any.
+  ///
+  /// When the `SWIFT_ARGUMENT_PARSER_TRACE` environment variable is set to
+  /// `1`, this is initially a tracer that writes a line of JSON to standard
+  /// error for each phase, like this:
+  ///
+  ///     {"phase":"decode","command":"math add","duration":0.000041}
+  ///
+  /// Set the variable to a path instead to append those lines to a file.
+  public static var tracer: ParseTracer? {
+    get {
+      tracerLock.lock()
+      defer { tracerLock.unlock() }
+      return installedTracer
+    }
+    set {
+      tracerLock.lock()
+      defer { tracerLock.unlock() }
+      installedTracer = newValue
+    }
+  }
+}
+
+private let tracerLock = NSLock()
+private var installedTracer: ParseTracer? = TraceLog.fromEnvironment()
+
+/// Runs `body` as the given phase, reporting it to the installed tracer.
+///
+/// `command` is only evaluated when a tracer is installed. When `isTraced`
+/// is `false`, `body` runs without being reported.
+func traced<T>(_ phase: ParsePhase, command: @autoclosure () -> String, if isTraced: Bool = true, _ body: () throws -> T) rethrows -> T {
+  guard isTraced, let tracer = ParseTracing.tracer else { return try body() }
+
+  let command = command()
+  tracer.phaseDidBegin(phase, command: command)
+  let start = DispatchTime.now().uptimeNanoseconds
+  defer {
+    let elapsed = DispatchTime.now().uptimeNanoseconds - start
+    tracer.phaseDidEnd(phase, command: command, duration: Double(elapsed) / 1_000_000_000)
+  }
+  return try body()
+}
+
+extension ParsableArguments {
+  /// The name to use for this type in traces: the full command name for a
+  /// command, and the type name for any other parsable type.
+  static var traceName: String {
+    (self as? ParsableCommand.Type)?._commandName ?? String(describing: self)
+  }
+}
+
+extension Array where Element == ParsableCommand.Type {
+  /// The names of the commands in this stack, separated by spaces.
+  var traceName: String {
+    map { $0._commandName }.joined(separator: " ")
+  }
+}
+
+/// The tracer enabled with `SWIFT_ARGUMENT_PARSER_TRACE`, which writes a line
+/// of JSON for each phase.
+private final class TraceLog: ParseTracer {
+  private let file: UnsafeMutablePointer<FILE>
+
+  private init(file: UnsafeMutablePointer<FILE>) {
+    self.file = file
+  }
+
+  static func fromEnvironment() -> TraceLog? {
+    guard let value = getenv("SWIFT_ARGUMENT_PARSER_TRACE").map({ String(cString: $0) }),
+      !value.isEmpty, value != "0"
+      else { return nil }
+
+    if value == "1" {
+      #if os(Windows)
+      return TraceLog(file: __acrt_iob_func(2))
+      #else
+      return TraceLog(file: stderr)
+      #endif
+    }
+    return fopen(value, "a").map(TraceLog.init(file:))
+  }
+
+  func phaseDidEnd(_ phase: ParsePhase, command: String, duration: Double) {
+    let line = #"{"phase":\#(phase.name.jsonQuoted),"command":\#(command.jsonQuoted),"duration":\#(duration)}"# + "\n"
+    // Each line is written with a single call, so lines from different
+    // threads don't interleave.
+    fputs(line, file)
+    fflush(file)
+  }
+}
+
+extension String {
+  /// This string as a quoted JSON string.
+  fileprivate var jsonQuoted: String {
+    var result = "\""
+    for scalar in unicodeScalars {
+      switch scalar {
+      case "\"": result += "\\\""
+      case "\\": result += "\\\\"
+      case "\n": result += "\\n"
+      case "\r": result += "\\r"
+      case "\t": result += "\\t"
+      case _ where scalar.value < 0x20:
+        result += "\\u" + String(repeating: "0", count: 4 - String(scalar.value, radix: 16).count)
+          + String(scalar.value, radix: 16)
+      default:
+        result.unicodeScalars.append(scalar)
+      }
+    }
+    return result + "\""
+  }
+}
@@ -10,35 +10,73 @@
 //===----------------------------------------------------------------------===//
 
 extension String {
-  func wrapped(to columns: Int, wrappingIndent: Int = 0) -> String {
-    let columns = columns - wrappingIndent
-    var result: [Substring] = []
-    
-    var currentIndex = startIndex
+  /// Returns this string wrapped to fit in `columns` display columns, with
+  /// each non-empty line indented by `wrappingIndent` spaces.
+  ///
+  /// Lines break at the last space that fits, or after an overlong word.
+  /// Existing line breaks are kept. The string is laid out in a single pass
+  /// and written into one buffer; strings that are entirely ASCII are laid
+  /// out by UTF-8 code unit, while others are laid out by character, with
+  /// East Asian wide characters and emoji taking two columns.
+  ///
+  /// - Parameters:
+  ///   - columns: The total width of each line, including the indentation.
+  ///   - wrappingIndent: The indentation for each line.
+  ///   - firstLineIndent: The indentation for the first line, if it's
+  ///     different from `wrappingIndent`. The first line still wraps as
+  ///     if it were indented by `wrappingIndent`.
+  func wrapped(to columns: Int, wrappingIndent: Int = 0, firstLineIndent: Int? = nil) -> String {
+    let columns = Swift.max(0, columns - wrappingIndent)
+    let firstLineIndent = Swift.max(0, firstLineIndent ?? wrappingIndent)
     
-    while true {
-      let nextChunk = self[currentIndex...].prefix(columns)
-      if let lastLineBreak = nextChunk.lastIndex(of: "\n") {
-        result.append(contentsOf: self[currentIndex..<lastLineBreak].split(separator: "\n", omittingEmptySubsequences: false))
-        currentIndex = index(after: lastLineBreak)
-      } else if nextChunk.endIndex == self.endIndex {
-        result.append(self[currentIndex...])
-        break
-      } else if let lastSpace = nextChunk.lastIndex(of: " ") {
-        result.append(self[currentIndex..<lastSpace])
-        currentIndex = index(after: lastSpace)
-      } else if let nextSpace = self[currentIndex...].firstIndex(of: " ") {
-        result.append(self[currentIndex..<nextSpace])
-        currentIndex = index(after: nextSpace)
-      } else {
-        result.append(self[currentIndex...])
-        break
+    let isASCII = utf8.allSatisfy { $0 < 0x80 && $0 != UInt8(ascii: "\r") }
+    if isASCII {
+      let bytes = Array(utf8)
+      var result: [UInt8] = []
+      result.reserveCapacity(bytes.count + (bytes.count / Swift.max(1, columns) + 1) * wrappingIndent)
+      
+      var isFirstLine = true
+      forEachWrappedLine(
+        of: bytes, columns: columns,
+        isNewline: { $0 == UInt8(ascii: "\n") },
+        isSpace: { $0 == UInt8(ascii: " ") },
+        width: { _ in 1 }
+      ) { line in
+        if !isFirstLine {
+          result.append(UInt8(ascii: "\n"))
+        }
+        if !line.isEmpty {
+          let indent = isFirstLine ? firstLineIndent : wrappingIndent
+          result.append(contentsOf: repeatElement(UInt8(ascii: " "), count: indent))
+          result.append(contentsOf: bytes[line])
+        }
+        isFirstLine = false
       }
+      return String(decoding: result, as: UTF8.self)
     }
     
+    let characters = Array(self)
+    var result = ""
+    result.reserveCapacity(utf8.count + (characters.count / Swift.max(1, columns) + 1) * wrappingIndent)
+    
+    var isFirstLine = true
+    forEachWrappedLine(
+      of: characters, columns: columns,
+      isNewline: { $0 == "\n" },
+      isSpace: { $0 == " " },
+      width: { $0.displayWidth }
+    ) { line in
+      if !isFirstLine {
+        result.append("\n")
+      }
+      if !line.isEmpty {
+        let indent = isFirstLine ? firstLineIndent : wrappingIndent
+        result.append(String(repeating: " ", count: indent))
+        result.append(contentsOf: characters[line])
+      }
+      isFirstLine = false
+    }
     return result
-      .map { $0.isEmpty ? $0 : String(repeating: " ", count: wrappingIndent) + $0 }
-      .joined(separator: "\n")
   }
   
   /// Returns this string prefixed using a camel-case style.
@@ -127,37 +165,46 @@ extension String {
   ///     // 1
 
   func editDistance(to target: String) -> Int {
-    let rows = self.count
-    let columns = target.count
-    
-    if rows <= 0 || columns <= 0 {
-      return max(rows, columns)
+    editDistance(to: target, maximum: Int.max)!
+  }
+  
+  /// Returns the edit distance between this string and the provided target
+  /// string, or `nil` if the distance is greater than `maximum`.
+  ///
+  /// Only the band of the distance matrix within `maximum` edits of the
+  /// diagonal is computed, one row at a time, and the computation stops as
+  /// soon as a whole row exceeds `maximum`. Strings that are entirely ASCII
+  /// are compared by code unit rather than by character.
+  func editDistance(to target: String, maximum: Int) -> Int? {
+    func isASCII(_ string: String) -> Bool {
+      // A carriage return and a following newline are a single character.
+      string.utf8.allSatisfy { $0 < 0x80 && $0 != UInt8(ascii: "\r") }
     }
     
-    var matrix = Array(repeating: Array(repeating: 0, count: columns + 1), count: rows + 1)
-    
-    for row in 1...rows {
-      matrix[row][0] = row
-    }
-    for column in 1...columns {
-      matrix[0][column] = column
+    if isASCII(self) && isASCII(target) {
+      return boundedEditDistance(Array(self.utf8), Array(target.utf8), maximum: maximum)
+    } else {
+      return boundedEditDistance(Array(self), Array(target), maximum: maximum)
     }
-    
-    for row in 1...rows {
-      for column in 1...columns {
-        let source = self[self.index(self.startIndex, offsetBy: row - 1)]
-        let target = target[target.index(target.startIndex, offsetBy: column - 1)]
-        let cost = source == target ? 0 : 1
-        
-        matrix[row][column] = Swift.min(
-          matrix[row - 1][column] + 1,
-          matrix[row][column - 1] + 1,
-          matrix[row - 1][column - 1] + cost
-        )
+  }
+  
+  /// Returns the string in `candidates` with the smallest edit distance to
+  /// this string, if any is within `maximumDistance`.
+  ///
+  /// Each candidate's distance is computed once, bounded by the best
+  /// distance found so far. When candidates are tied, the first one wins.
+  func closestMatch<S: Sequence>(in candidates: S, maximumDistance: Int) -> String?
+    where S.Element == String
+  {
+    var best: (candidate: String, distance: Int)?
+    for candidate in candidates {
+      let limit = best.map { $0.distance - 1 } ?? maximumDistance
+      guard limit >= 0 else { break }
+      if let distance = editDistance(to: candidate, maximum: limit) {
+        best = (candidate, distance)
       }
     }
-    
-    return matrix.last!.last!
+    return best?.candidate
   }
   
   func indentingEachLine(by n: Int) -> String {
@@ -172,3 +219,135 @@ extension String {
     }
   }
 }
+
+/// Returns the Levenshtein distance between `source` and `target`, or `nil`
+/// if it's greater than `maximum`.
+fileprivate func boundedEditDistance<T: Equatable>(_ source: [T], _ target: [T], maximum: Int) -> Int? {
+  let rows = source.count
+  let columns = target.count
+  let limit = min(maximum, max(rows, columns))
+  
+  guard limit >= 0, abs(rows - columns) <= limit else { return nil }
+  if rows == 0 || columns == 0 {
+    return max(rows, columns)
+  }
+  
+  // Any distance above `limit` is stored as `infinity`, so that additions
+  // can't overflow.
+  let infinity = limit + 1
+  var previous = (0...columns).map { min($0, infinity) }
+  var current = Array(repeating: infinity, count: columns + 1)
+  
+  for row in 1...rows {
+    // Only the cells within `limit` of the diagonal can be within `limit`.
+    let low = max(1, row - limit)
+    let high = min(columns, row + limit)
+    
+    current[low - 1] = low == 1 ? min(row, infinity) : infinity
+    var rowMinimum = current[low - 1]
+    for column in low...high {
+      let cost = source[row - 1] == target[column - 1] ? 0 : 1
+      let insertionOrDeletion = min(previous[column], current[column - 1]) + 1
+      current[column] = min(min(insertionOrDeletion, previous[column - 1] + cost), infinity)
+      rowMinimum = min(rowMinimum, current[column])
+    }
+    if high < columns {
+      current[high + 1] = infinity
+    }
+    
+    guard rowMinimum <= limit else { return nil }
+    swap(&previous, &current)
+  }
+  
+  return previous[columns] <= limit ? previous[columns] : nil
+}
+
+/// Breaks `units` into lines that are at most `columns` wide, calling
+/// `emitLine` with the range of each line, in order.
+///
+/// Each line is found by scanning forward from the end of the previous one
+/// until the next unit wouldn't fit. If that span includes line breaks, it's
+/// split at each of them. Otherwise, it breaks at the span's last space, or,
+/// if there isn't one, at the first space after it. A line with spaces is
+/// therefore at most `columns - 1` wide, unless it ends the input.
+fileprivate func forEachWrappedLine<T>(
+  of units: [T],
+  columns: Int,
+  isNewline: (T) -> Bool,
+  isSpace: (T) -> Bool,
+  width: (T) -> Int,
+  _ emitLine: (Range<Int>) -> Void
+) {
+  var current = 0
+  while true {
+    var windowEnd = current
+    var usedWidth = 0
+    var lastNewline: Int?
+    var lastSpace: Int?
+    while windowEnd < units.endIndex {
+      let unit = units[windowEnd]
+      usedWidth += width(unit)
+      guard usedWidth <= columns else { break }
+      if isNewline(unit) {
+        lastNewline = windowEnd
+      } else if isSpace(unit) {
+        lastSpace = windowEnd
+      }
+      windowEnd += 1
+    }
+    
+    if let lastNewline = lastNewline {
+      var lineStart = current
+      for i in current..<lastNewline where isNewline(units[i]) {
+        emitLine(lineStart..<i)
+        lineStart = i + 1
+      }
+      emitLine(lineStart..<lastNewline)
+      current = lastNewline + 1
+    } else if windowEnd == units.endIndex {
+      emitLine(current..<units.endIndex)
+      return
+    } else if let lastSpace = lastSpace {
+      emitLine(current..<lastSpace)
+      current = lastSpace + 1
+    } else if let nextSpace = units[windowEnd...].firstIndex(where: isSpace) {
+      emitLine(current..<nextSpace)
+      current = nextSpace + 1
+    } else {
+      emitLine(current..<units.endIndex)
+      return
+    }
+  }
+}
+
+extension Character {
+  /// The number of columns this character takes up in a terminal.
+  ///
+  /// East Asian wide and fullwidth characters, and most emoji, take two
+  /// columns; everything else takes one.
+  var displayWidth: Int {
+    guard let scalar = unicodeScalars.first, scalar.value >= 0x1100 else {
+      return 1
+    }
+    switch scalar.value {
+    case 0x1100...0x115F,   // Hangul Jamo
+         0x2E80...0x303E,   // CJK radicals, Kangxi, CJK symbols
+         0x3041...0x33FF,   // Hiragana, Katakana, CJK compatibility
+         0x3400...0x4DBF,   // CJK Unified Ideographs Extension A
+         0x4E00...0x9FFF,   // CJK Unified Ideographs
+         0xA000...0xA4CF,   // Yi
+         0xAC00...0xD7A3,   // Hangul syllables
+         0xF900...0xFAFF,   // CJK compatibility ideographs
+         0xFE30...0xFE4F,   // CJK compatibility forms
+         0xFF00...0xFF60,   // Fullwidth forms
+         0xFFE0...0xFFE6,
+         0x1F300...0x1F64F, // Pictographs and emoticons
+         0x1F900...0x1F9FF, // Supplemental symbols and pictographs
+         0x20000...0x2FFFD, // CJK Unified Ideographs Extensions B-F
+         0x30000...0x3FFFD:
+      return 2
+    default:
+      return 1
+    }
+  }
+}
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+@_implementationOnly import Foundation
+
+/// A process-wide cache that can be safely read and written from multiple
+/// threads.
+///
+/// The lock is only held while reading or writing the storage, never while
+/// computing a new value, so building a value is free to consult the same
+/// cache (for example, when an argument set includes an option group).
+final class SynchronizedCache<Key: Hashable, Value> {
+  private var storage: [Key: Value] = [:]
+  private let lock = NSLock()
+
+  init() {}
+
+  subscript(key: Key) -> Value? {
+    lock.lock()
+    defer { lock.unlock() }
+    return storage[key]
+  }
+
+  /// Stores `value` for `key`, unless another thread stored a value first.
+  ///
+  /// - Returns: The value that is in the cache for `key` after the call.
+  @discardableResult
+  func insert(_ value: Value, forKey key: Key) -> Value {
+    lock.lock()
+    defer { lock.unlock() }
+    if let existing = storage[key] {
+      return existing
+    }
+    storage[key] = value
+    return value
+  }
+
+  /// Returns the cached value for `key`, calling `makeValue` and storing its
+  /// result when there isn't one yet.
+  func value(forKey key: Key, orInsert makeValue: () throws -> Value) rethrows -> Value {
+    if let cached = self[key] {
+      return cached
+    }
+    return insert(try makeValue(), forKey: key)
+  }
+
+  /// Removes every cached value.
+  func removeAll() {
+    lock.lock()
+    defer { lock.unlock() }
+    storage.removeAll()
+  }
+}
@@ -9,10 +9,32 @@
 //
 //===----------------------------------------------------------------------===//
 
+@_implementationOnly import Foundation
+
+/// Guards the expansion of lazily built nodes, which can happen on any thread
+/// that reads a shared tree.
+private let expansionLock = NSLock()
+
 final class Tree<Element> {
   var element: Element
   weak var parent: Tree?
-  var children: [Tree]
+  private var _children: [Tree] = []
+  
+  /// The children of this node, indexed by name, for trees whose elements
+  /// have names.
+  ///
+  /// When more than one child has the same name, the first one is stored,
+  /// matching a linear search of `children`.
+  private var childrenByName: [String: Tree] = [:]
+  
+  /// Builds this node's children, along with the name to index each one by,
+  /// the first time they're needed; `nil` once they're built.
+  private var makeChildren: (() -> [(tree: Tree, name: String?)])?
+  
+  var children: [Tree] {
+    expandIfNeeded()
+    return _children
+  }
   
   var isRoot: Bool { parent == nil }
   var isLeaf: Bool { children.isEmpty }
@@ -21,12 +43,46 @@ final class Tree<Element> {
   init(_ element: Element) {
     self.element = element
     self.parent = nil
-    self.children = []
+  }
+  
+  /// Creates a node whose children are built by `makeChildren` the first
+  /// time they're accessed.
+  init(_ element: Element, lazyChildren makeChildren: @escaping () -> [(tree: Tree, name: String?)]) {
+    self.element = element
+    self.parent = nil
+    self.makeChildren = makeChildren
   }
   
   func addChild(_ tree: Tree) {
-    children.append(tree)
+    addChild(tree, name: nil)
+  }
+  
+  fileprivate func addChild(_ tree: Tree, name: String?) {
+    expandIfNeeded()
+    insert(tree, name: name)
+  }
+  
+  fileprivate func child(named name: String) -> Tree? {
+    expandIfNeeded()
+    return childrenByName[name]
+  }
+  
+  private func insert(_ tree: Tree, name: String?) {
+    _children.append(tree)
     tree.parent = self
+    if let name = name, childrenByName[name] == nil {
+      childrenByName[name] = tree
+    }
+  }
+  
+  private func expandIfNeeded() {
+    expansionLock.lock()
+    defer { expansionLock.unlock() }
+    guard let makeChildren = makeChildren else { return }
+    self.makeChildren = nil
+    for (tree, name) in makeChildren() {
+      insert(tree, name: name)
+    }
   }
 }
 
@@ -85,16 +141,40 @@ extension Tree where Element == ParsableCommand.Type {
   }
   
   func firstChild(withName name: String) -> Tree? {
-    children.first(where: { $0.element._commandName == name })
+    child(named: name)
+  }
+  
+  /// Adds `tree` as a child, indexed by its command name for
+  /// `firstChild(withName:)`.
+  func addSubcommand(_ tree: Tree) {
+    addChild(tree, name: tree.element._commandName)
+  }
+  
+  /// Creates a tree for `command` and its subcommands, building each node's
+  /// children only when they're first accessed.
+  ///
+  /// Parsing a command line only visits the path to the selected command,
+  /// so the configurations of the other commands in a large tree are never
+  /// evaluated.
+  static func lazilyBuilt(root command: ParsableCommand.Type) -> Tree {
+    Tree(command) {
+      command.configuration.subcommands.map { subcommand -> (tree: Tree, name: String?) in
+        if subcommand == command {
+          fatalError("The ParsableCommand \"\(subcommand)\" can't have itself as its own subcommand.")
+        }
+        return (lazilyBuilt(root: subcommand), subcommand._commandName)
+      }
+    }
   }
   
+  /// Creates a fully built tree for `command` and its subcommands.
   convenience init(root command: ParsableCommand.Type) throws {
     self.init(command)
     for subcommand in command.configuration.subcommands {
       if subcommand == command {
         throw InitializationError.recursiveSubcommand(subcommand)
       }
-      try addChild(Tree(root: subcommand))
+      try addSubcommand(Tree(root: subcommand))
     }
   }
     
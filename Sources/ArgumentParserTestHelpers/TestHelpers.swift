@@ -151,6 +151,11 @@ public func AssertDump<T: ParsableArguments>(
   }
    
   try AssertJSONEqualFromString(actual: T.dumpMessage(), expected: expected, for: HelpInfo.self)
+  
+  // The compact dump has the same contents.
+  let expectedJSONData = try XCTUnwrap(expected.data(using: .utf8))
+  let expectedInfo = try JSONDecoder().decode(HelpInfo.self, from: expectedJSONData)
+  XCTAssertEqual(try HelpInfo(compactDump: T.compactDumpMessage()), expectedInfo, file: (file), line: line)
 }
 
 public func AssertJSONEqualFromString<T: Codable & Equatable>(actual: String, expected: String, for type: T.Type) throws {
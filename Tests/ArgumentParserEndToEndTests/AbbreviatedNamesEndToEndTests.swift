@@ -0,0 +1,60 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ArgumentParserTestHelpers
+import ArgumentParser
+
+final class AbbreviatedNamesEndToEndTests: XCTestCase {
+}
+
+fileprivate struct Abbreviated: ParsableCommand {
+  static var configuration = CommandConfiguration(allowsAbbreviatedNames: true)
+
+  @Flag var verbose = false
+  @Option var version: String = ""
+  @Option var output: String = ""
+  @Option var outputFormat: String = ""
+}
+
+fileprivate struct Unabbreviated: ParsableCommand {
+  @Flag var verbose = false
+}
+
+extension AbbreviatedNamesEndToEndTests {
+  func testAbbreviations() throws {
+    AssertParse(Abbreviated.self, ["--verb", "--vers", "1.0", "--output-f=json"]) { command in
+      XCTAssertTrue(command.verbose)
+      XCTAssertEqual(command.version, "1.0")
+      XCTAssertEqual(command.output, "")
+      XCTAssertEqual(command.outputFormat, "json")
+    }
+  }
+
+  func testExactMatchWins() throws {
+    AssertParse(Abbreviated.self, ["--output", "a"]) { command in
+      XCTAssertEqual(command.output, "a")
+      XCTAssertEqual(command.outputFormat, "")
+    }
+  }
+
+  func testAmbiguousAbbreviation() throws {
+    XCTAssertThrowsError(try Abbreviated.parse(["--ver"]))
+    XCTAssertThrowsError(try Abbreviated.parse(["--out", "a"]))
+  }
+
+  func testAbbreviationsAreOptIn() throws {
+    XCTAssertThrowsError(try Unabbreviated.parse(["--verb"]))
+    AssertParse(Unabbreviated.self, ["--verbose"]) { command in
+      XCTAssertTrue(command.verbose)
+    }
+  }
+}
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ArgumentParserTestHelpers
+import ArgumentParser
+import Dispatch
+import Foundation
+
+final class CommandLineParserEndToEndTests: XCTestCase {
+}
+
+fileprivate struct Root: ParsableCommand {
+  static var configuration = CommandConfiguration(subcommands: [Add.self, Echo.self])
+}
+
+fileprivate struct Add: ParsableCommand {
+  @Flag var verbose = false
+  @Argument var values: [Int] = []
+}
+
+fileprivate struct Echo: ParsableCommand {
+  @Option var prefix: String = ""
+  @Argument var words: [String]
+}
+
+extension CommandLineParserEndToEndTests {
+  func testParsing() throws {
+    let parser = CommandLineParser(rootCommand: Root.self)
+    XCTAssertTrue(parser.rootCommand == Root.self)
+    
+    let add = try XCTUnwrap(parser.parse(["add", "--verbose", "1", "2"]) as? Add)
+    XCTAssertTrue(add.verbose)
+    XCTAssertEqual(add.values, [1, 2])
+    
+    let echo = try XCTUnwrap(parser.parse(["echo", "--prefix", ">", "a", "b"]) as? Echo)
+    XCTAssertEqual(echo.prefix, ">")
+    XCTAssertEqual(echo.words, ["a", "b"])
+  }
+  
+  func testErrors() throws {
+    let parser = CommandLineParser(rootCommand: Root.self)
+    
+    XCTAssertThrowsError(try parser.parse(["add", "x"])) { error in
+      XCTAssertEqual(parser.exitCode(for: error), .validationFailure)
+      XCTAssertEqual(parser.fullMessage(for: error), Root.fullMessage(for: error))
+      XCTAssertTrue(parser.fullMessage(for: error).hasPrefix("Error: "))
+    }
+    
+    XCTAssertThrowsError(try parser.parse(["echo"])) { error in
+      XCTAssertEqual(parser.exitCode(for: error), .validationFailure)
+    }
+  }
+  
+  func testCompletionRequestsAreNotHandled() throws {
+    let parser = CommandLineParser(rootCommand: Root.self)
+    
+    for request in [
+      ["---completion-server"],
+      ["---completion-function", "bash"],
+      ["---completion", "echo", "--", "--prefix", ""],
+    ] {
+      XCTAssertThrowsError(try parser.parse(request)) { error in
+        XCTAssertEqual(parser.exitCode(for: error), .validationFailure)
+        XCTAssertEqual(Root.message(for: error), "Invalid option: \(request[0])")
+      }
+    }
+  }
+  
+  func testConcurrentParsing() {
+    let parser = CommandLineParser(rootCommand: Root.self)
+    let iterations = 200
+    var results = Array(repeating: [Int](), count: iterations)
+    let lock = NSLock()
+    
+    DispatchQueue.concurrentPerform(iterations: iterations) { i in
+      let values = (try? parser.parse(["add", "\(i)", "\(i + 1)"]) as? Add)?.values ?? []
+      lock.lock()
+      results[i] = values
+      lock.unlock()
+    }
+    
+    for (i, values) in results.enumerated() {
+      XCTAssertEqual(values, [i, i + 1])
+    }
+  }
+}
@@ -166,3 +166,35 @@ extension ParsingEndToEndTests {
   }
 }
 
+
+// MARK: -
+
+fileprivate struct Temperature: ExpressibleByArgument, Decodable {
+  var degrees: Int
+  var wasDecoded = false
+
+  init?(argument: String) {
+    guard let degrees = Int(argument) else { return nil }
+    self.degrees = degrees
+  }
+
+  init(from decoder: Decoder) throws {
+    self = try decoder.singleValueContainer().decode(Temperature.self)
+    wasDecoded = true
+  }
+}
+
+fileprivate struct Thermostat: ParsableCommand {
+  @Option var target: Temperature
+  @Argument var current: Temperature?
+}
+
+extension ParsingEndToEndTests {
+  func testParsing_CustomDecodable() throws {
+    AssertParse(Thermostat.self, ["--target", "20", "18"]) { thermostat in
+      XCTAssertEqual(thermostat.target.degrees, 20)
+      XCTAssertTrue(thermostat.target.wasDecoded)
+      XCTAssertEqual(thermostat.current?.degrees, 18)
+    }
+  }
+}
@@ -0,0 +1,105 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ArgumentParserTestHelpers
+import ArgumentParser
+import Foundation
+
+final class InputLinesEndToEndTests: XCTestCase {
+}
+
+fileprivate struct Archive: ParsableArguments {
+  @Option(name: .customLong("files-from")) var files: InputLines
+  @Argument var extra: [String] = []
+}
+
+fileprivate struct NullSeparatedArchive: ParsableArguments {
+  @Option(name: .customLong("files-from"), transform: InputLines.separated(by: 0))
+  var files: InputLines
+}
+
+fileprivate func withTemporaryFile(contents: String, _ body: (String) throws -> Void) throws {
+  let url = FileManager.default.temporaryDirectory
+    .appendingPathComponent("InputLinesEndToEndTests-\(UUID().uuidString).txt")
+  try contents.write(to: url, atomically: true, encoding: .utf8)
+  defer { try? FileManager.default.removeItem(at: url) }
+  try body(url.path)
+}
+
+extension InputLinesEndToEndTests {
+  func testReadingLines() throws {
+    try withTemporaryFile(contents: "a.txt\nb c.txt\r\n\nlast.txt") { path in
+      AssertParse(Archive.self, ["--files-from", path, "x"]) { archive in
+        XCTAssertEqual(archive.files.path, path)
+        XCTAssertFalse(archive.files.isStandardInput)
+        XCTAssertEqual(Array(archive.files), ["a.txt", "b c.txt", "", "last.txt"])
+        XCTAssertEqual(archive.extra, ["x"])
+      }
+    }
+  }
+
+  func testIteratingTwice() throws {
+    try withTemporaryFile(contents: "one\ntwo\n") { path in
+      AssertParse(Archive.self, ["--files-from", path]) { archive in
+        XCTAssertEqual(Array(archive.files), ["one", "two"])
+        XCTAssertEqual(Array(archive.files), ["one", "two"])
+      }
+    }
+  }
+
+  func testLongLines() throws {
+    let long = String(repeating: "x", count: 10_000)
+    try withTemporaryFile(contents: "\(long)\nshort\n") { path in
+      AssertParse(Archive.self, ["--files-from", path]) { archive in
+        XCTAssertEqual(Array(archive.files), [long, "short"])
+      }
+    }
+  }
+
+  func testStandardInput() throws {
+    AssertParse(Archive.self, ["--files-from", "-"]) { archive in
+      XCTAssertTrue(archive.files.isStandardInput)
+    }
+  }
+
+  func testNullSeparator() throws {
+    try withTemporaryFile(contents: "a b.txt\0line\nbreak.txt\0\0last\r\n") { path in
+      AssertParse(NullSeparatedArchive.self, ["--files-from", path]) { archive in
+        XCTAssertEqual(archive.files.separator, 0)
+        XCTAssertEqual(Array(archive.files), ["a b.txt", "line\nbreak.txt", "", "last\r\n"])
+      }
+    }
+  }
+
+  func testNullBytesInLines() throws {
+    try withTemporaryFile(contents: "a\0b\nc\n") { path in
+      AssertParse(Archive.self, ["--files-from", path]) { archive in
+        XCTAssertEqual(Array(archive.files), ["a\0b", "c"])
+      }
+    }
+  }
+
+  func testFileRemovedAfterParsing() throws {
+    var files: InputLines?
+    try withTemporaryFile(contents: "a\n") { path in
+      files = try Archive.parse(["--files-from", path]).files
+    }
+    XCTAssertThrowsError(try files!.open()) { error in
+      XCTAssertTrue(error is InputLines.OpenError)
+    }
+  }
+
+  func testMissingFile() throws {
+    let path = "/nonexistent/InputLinesEndToEndTests.txt"
+    AssertErrorMessage(Archive.self, ["--files-from", path], "The value '\(path)' is invalid for '--files-from <files-from>'")
+  }
+}
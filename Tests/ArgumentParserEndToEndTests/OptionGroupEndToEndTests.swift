@@ -108,3 +108,73 @@ extension OptionGroupEndToEndTests {
     XCTAssertThrowsError(try Outer.parse(["prefix", "name", "postfix", "--size", "a"]))
   }
 }
+
+// MARK: - Lazy option groups
+
+fileprivate var lazyConversionCount = 0
+
+fileprivate struct Expensive: ParsableArguments {
+  @Option(transform: { (s: String) -> Int in
+    lazyConversionCount += 1
+    return Int(s) ?? 0
+  })
+  var level: Int = 1
+
+  @Flag(name: .shortAndLong)
+  var quiet: Bool = false
+
+  @Argument
+  var paths: [String] = []
+}
+
+fileprivate struct LazyCommand: ParsableCommand {
+  @Flag var verbose: Bool = false
+  @OptionGroup(lazy: true) var expensive: Expensive
+}
+
+fileprivate struct RequiredOptions: ParsableArguments {
+  @Option var name: String
+}
+
+fileprivate struct LazyRequiredCommand: ParsableCommand {
+  @OptionGroup(lazy: true) var required: RequiredOptions
+}
+
+extension OptionGroupEndToEndTests {
+  func testLazyOptionGroup() throws {
+    lazyConversionCount = 0
+    let command = try LazyCommand.parse(["--level", "3", "-q", "--verbose", "a", "b"])
+    XCTAssertTrue(command.verbose)
+    XCTAssertEqual(lazyConversionCount, 0)
+
+    XCTAssertEqual(command.expensive.level, 3)
+    XCTAssertEqual(command.expensive.quiet, true)
+    XCTAssertEqual(command.expensive.paths, ["a", "b"])
+    XCTAssertEqual(lazyConversionCount, 1)
+  }
+
+  func testLazyOptionGroup_Defaults() throws {
+    AssertParse(LazyCommand.self, []) { command in
+      XCTAssertFalse(command.verbose)
+      XCTAssertEqual(command.expensive.level, 1)
+      XCTAssertEqual(command.expensive.quiet, false)
+      XCTAssertEqual(command.expensive.paths, [])
+    }
+  }
+
+  func testLazyOptionGroup_ThrowingAccess() throws {
+    let command = try LazyRequiredCommand.parse([])
+    XCTAssertThrowsError(try command.$required.value()) { error in
+      XCTAssertEqual(LazyRequiredCommand.message(for: error), "Missing expected argument '--name <name>'")
+    }
+
+    let named = try LazyRequiredCommand.parse(["--name", "a"])
+    XCTAssertEqual(try named.$required.value().name, "a")
+    XCTAssertEqual(named.required.name, "a")
+  }
+
+  func testLazyOptionGroup_Fails() throws {
+    XCTAssertThrowsError(try LazyCommand.parse(["--level"]))
+    XCTAssertThrowsError(try LazyCommand.parse(["--unknown"]))
+  }
+}
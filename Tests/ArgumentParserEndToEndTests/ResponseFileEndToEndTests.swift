@@ -0,0 +1,120 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ArgumentParserTestHelpers
+import ArgumentParser
+import Foundation
+
+final class ResponseFileEndToEndTests: XCTestCase {
+}
+
+fileprivate struct Compile: ParsableCommand {
+  static var configuration = CommandConfiguration(allowsResponseFiles: true)
+
+  @Flag var verbose = false
+  @Option var define: [String] = []
+  @Argument var files: [String] = []
+}
+
+fileprivate struct Literal: ParsableCommand {
+  @Argument var files: [String] = []
+}
+
+fileprivate func withResponseFiles(_ contents: [String], _ body: ([String]) throws -> Void) throws {
+  let directory = FileManager.default.temporaryDirectory
+    .appendingPathComponent("ResponseFileEndToEndTests-\(UUID().uuidString)")
+  try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+  defer { try? FileManager.default.removeItem(at: directory) }
+
+  let paths = contents.indices.map { directory.appendingPathComponent("\($0).rsp").path }
+  for (path, contents) in zip(paths, contents) {
+    // Files refer to each other as @0, @1, and so on.
+    var contents = contents
+    for (i, path) in paths.enumerated() {
+      contents = contents.replacingOccurrences(of: "@\(i)", with: "@\(path)")
+    }
+    try contents.write(toFile: path, atomically: true, encoding: .utf8)
+  }
+  try body(paths)
+}
+
+extension ResponseFileEndToEndTests {
+  func testExpansion() throws {
+    let contents = """
+      --verbose a.swift
+        "b c.swift" 'd "e".swift'
+      --define=X\\ Y "--define=\\"Z\\""
+      ""
+      """
+    try withResponseFiles([contents]) { paths in
+      AssertParse(Compile.self, ["first.swift", "@\(paths[0])", "last.swift"]) { compile in
+        XCTAssertTrue(compile.verbose)
+        XCTAssertEqual(compile.define, ["X Y", "\"Z\""])
+        XCTAssertEqual(compile.files, ["first.swift", "a.swift", "b c.swift", "d \"e\".swift", "", "last.swift"])
+      }
+    }
+  }
+
+  func testNestedExpansion() throws {
+    try withResponseFiles(["one @1 four", "two\r\nthree\r\n", "--", "@0"]) { paths in
+      AssertParse(Compile.self, ["@\(paths[0])"]) { compile in
+        XCTAssertEqual(compile.files, ["one", "two", "three", "four"])
+      }
+
+      // Arguments after a terminator aren't expanded.
+      AssertParse(Compile.self, ["@\(paths[2])", "@\(paths[3])"]) { compile in
+        XCTAssertEqual(compile.files, ["@\(paths[3])"])
+      }
+    }
+  }
+
+  func testExpansionErrors() throws {
+    try withResponseFiles(["a\n\"b", "@1", "@3", "x @2"]) { paths in
+      AssertErrorMessage(Compile.self, ["@\(paths[0])"], "\(paths[0]):2: Missing closing quote")
+      AssertErrorMessage(Compile.self, ["@\(paths[1])"], "\(paths[1]):1: Response file '\(paths[1])' includes itself")
+      AssertErrorMessage(Compile.self, ["@\(paths[2])"], "\(paths[3]):1: Response file '\(paths[2])' includes itself")
+      AssertErrorMessage(Compile.self, ["@\(paths[0]).missing"], "Couldn't open response file '\(paths[0]).missing'")
+    }
+  }
+
+  func testPipe() throws {
+    #if !os(Windows)
+    let path = FileManager.default.temporaryDirectory
+      .appendingPathComponent("ResponseFileEndToEndTests-\(UUID().uuidString).fifo").path
+    XCTAssertEqual(mkfifo(path, 0o600), 0)
+    defer { try? FileManager.default.removeItem(atPath: path) }
+
+    // The contents are larger than a single chunk, so they take several reads.
+    let files = (0..<20_000).map { "file\($0).swift" }
+    let writer = Thread {
+      // Opening a FIFO for writing waits until the parser opens it to read.
+      guard let handle = FileHandle(forWritingAtPath: path) else { return }
+      handle.write(files.joined(separator: "\n").data(using: .utf8)!)
+      handle.closeFile()
+    }
+    writer.start()
+
+    AssertParse(Compile.self, ["@\(path)"]) { compile in
+      XCTAssertEqual(compile.files, files)
+    }
+    #endif
+  }
+
+  func testDisabledByDefault() throws {
+    AssertParse(Literal.self, ["@missing", "@"]) { literal in
+      XCTAssertEqual(literal.files, ["@missing", "@"])
+    }
+    AssertParse(Compile.self, ["@"]) { compile in
+      XCTAssertEqual(compile.files, ["@"])
+    }
+  }
+}
@@ -161,3 +161,41 @@ extension TransformEndToEndTests {
     AssertFullErrorMessage(BarArgument.self, ["4827", "72", "99"], "Error: The value '4827' is invalid for '<int_str>': outOfBounds\n" + BarArgument.help + BarArgument.usageString)
   }
 }
+
+// MARK: - Concurrent Conversion
+
+fileprivate struct ConcurrentArrays: Convert, ParsableArguments {
+  @Option(conversion: .concurrent, transform: { try convert($0) })
+  var numbers: [Int] = [1, 2, 3]
+
+  @Option(conversion: .concurrent)
+  var names: [String] = []
+
+  @Argument(conversion: .concurrent, transform: { try convert($0) })
+  var values: [Int] = []
+}
+
+extension TransformEndToEndTests {
+  func testConcurrentConversion() throws {
+    let values = (0..<200).map(String.init)
+    AssertParse(ConcurrentArrays.self, values) { arrays in
+      XCTAssertEqual(arrays.numbers, [1, 2, 3])
+      XCTAssertEqual(arrays.names, [])
+      XCTAssertEqual(arrays.values, Array(0..<200))
+    }
+
+    AssertParse(ConcurrentArrays.self, ["--numbers", "5", "7", "--names", "a", "--numbers", "6", "--names", "b"]) { arrays in
+      XCTAssertEqual(arrays.numbers, [5, 6])
+      XCTAssertEqual(arrays.names, ["a", "b"])
+      XCTAssertEqual(arrays.values, [7])
+    }
+  }
+
+  func testConcurrentConversion_Fail() throws {
+    var values = (0..<200).map(String.init)
+    values[150] = "Forty Two"
+    values[170] = "4827"
+    AssertErrorMessage(ConcurrentArrays.self, values, "The value 'Forty Two' is invalid for '<values>': Could not transform to an Int.")
+    AssertErrorMessage(ConcurrentArrays.self, ["--numbers", "4827", "--numbers", "five"], "The value '4827' is invalid for '--numbers <numbers>': outOfBounds")
+  }
+}
@@ -0,0 +1,210 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ArgumentParserTestHelpers
+import ArgumentParser
+import Foundation
+
+final class ValueSourceEndToEndTests: XCTestCase {
+}
+
+fileprivate var configurationPath = ""
+
+fileprivate struct Tool: ParsableCommand {
+  static var configuration: CommandConfiguration {
+    CommandConfiguration(valueSources: [
+      .environment(prefix: "VALUE_SOURCE_TEST_"),
+      .configurationFile(atPath: configurationPath),
+    ])
+  }
+
+  @Option var jobs: Int = 1
+  @Option var outputPath: String?
+  @Option var include: [String] = ["default"]
+  @Flag var verbose = false
+  @Flag(inversion: .prefixedNo) var color = true
+  @Argument var files: [String] = []
+}
+
+fileprivate struct LazyOptions: ParsableArguments {
+  @Option var level: Int = 0
+  @Option var tag: [String] = []
+}
+
+fileprivate struct LazyTool: ParsableCommand {
+  static var configuration: CommandConfiguration {
+    CommandConfiguration(valueSources: [.environment(prefix: "VALUE_SOURCE_TEST_")])
+  }
+
+  @OptionGroup(lazy: true) var options: LazyOptions
+}
+
+fileprivate func withConfiguration(_ contents: String, _ body: () throws -> Void) throws {
+  let url = FileManager.default.temporaryDirectory
+    .appendingPathComponent("ValueSourceEndToEndTests-\(UUID().uuidString).json")
+  try contents.write(to: url, atomically: true, encoding: .utf8)
+  defer { try? FileManager.default.removeItem(at: url) }
+  configurationPath = url.path
+  try body()
+}
+
+fileprivate func withEnvironment(_ variables: [String: String], _ body: () throws -> Void) rethrows {
+  for (name, value) in variables {
+    setenv("VALUE_SOURCE_TEST_" + name, value, 1)
+  }
+  defer {
+    for name in variables.keys {
+      unsetenv("VALUE_SOURCE_TEST_" + name)
+    }
+  }
+  try body()
+}
+
+extension ValueSourceEndToEndTests {
+  func testNoSources() throws {
+    configurationPath = "/nonexistent/value-source-test.json"
+    AssertParse(Tool.self, ["a"]) { tool in
+      XCTAssertEqual(tool.jobs, 1)
+      XCTAssertNil(tool.outputPath)
+      XCTAssertEqual(tool.include, ["default"])
+      XCTAssertFalse(tool.verbose)
+      XCTAssertTrue(tool.color)
+      XCTAssertEqual(tool.files, ["a"])
+    }
+  }
+
+  func testEnvironment() throws {
+    configurationPath = "/nonexistent/value-source-test.json"
+    try withEnvironment(["JOBS": "8", "OUTPUT_PATH": "out", "VERBOSE": "yes", "NO_COLOR": "1"]) {
+      AssertParse(Tool.self, []) { tool in
+        XCTAssertEqual(tool.jobs, 8)
+        XCTAssertEqual(tool.outputPath, "out")
+        XCTAssertTrue(tool.verbose)
+        XCTAssertFalse(tool.color)
+      }
+
+      // The command line takes precedence.
+      AssertParse(Tool.self, ["--jobs", "2", "--color"]) { tool in
+        XCTAssertEqual(tool.jobs, 2)
+        XCTAssertTrue(tool.color)
+      }
+    }
+  }
+
+  func testFalseFlagValues() throws {
+    configurationPath = "/nonexistent/value-source-test.json"
+    try withEnvironment(["COLOR": "false", "VERBOSE": "no"]) {
+      AssertParse(Tool.self, []) { tool in
+        XCTAssertFalse(tool.color)
+        XCTAssertFalse(tool.verbose)
+      }
+      AssertParse(Tool.self, ["--color"]) { tool in
+        XCTAssertTrue(tool.color)
+      }
+    }
+    try withEnvironment(["NO_COLOR": "0"]) {
+      AssertParse(Tool.self, []) { tool in
+        XCTAssertTrue(tool.color)
+      }
+    }
+    try withEnvironment(["COLOR": "off"]) {
+      AssertParse(Tool.self, ["--jobs", "2"]) { tool in
+        XCTAssertEqual(tool.jobs, 2)
+        XCTAssertFalse(tool.color)
+      }
+    }
+  }
+
+  func testLazyOptionGroup() throws {
+    try withEnvironment(["LEVEL": "5", "TAG": "env"]) {
+      AssertParse(LazyTool.self, []) { tool in
+        XCTAssertEqual(tool.options.level, 5)
+        XCTAssertEqual(tool.options.tag, ["env"])
+      }
+
+      // The command line takes precedence inside a lazy group, too.
+      AssertParse(LazyTool.self, ["--level", "3", "--tag", "a"]) { tool in
+        XCTAssertEqual(tool.options.level, 3)
+        XCTAssertEqual(tool.options.tag, ["a"])
+      }
+      AssertParse(LazyTool.self, ["--tag", "a"]) { tool in
+        XCTAssertEqual(tool.options.level, 5)
+        XCTAssertEqual(tool.options.tag, ["a"])
+      }
+    }
+  }
+
+  func testConfigurationFile() throws {
+    let json = """
+      {
+        "jobs": 4,
+        "include": ["a", "b\\u00e9", "c\\"d"],
+        "verbose": true,
+        "output-path": null,
+        "unrelated": 1.5e3
+      }
+      """
+    try withConfiguration(json) {
+      AssertParse(Tool.self, []) { tool in
+        XCTAssertEqual(tool.jobs, 4)
+        XCTAssertNil(tool.outputPath)
+        XCTAssertEqual(tool.include, ["a", "bé", "c\"d"])
+        XCTAssertTrue(tool.verbose)
+      }
+
+      AssertParse(Tool.self, ["--include", "x"]) { tool in
+        XCTAssertEqual(tool.include, ["x"])
+      }
+
+      // The environment is listed first, so it takes precedence.
+      try withEnvironment(["JOBS": "16"]) {
+        AssertParse(Tool.self, []) { tool in
+          XCTAssertEqual(tool.jobs, 16)
+          XCTAssertEqual(tool.include, ["a", "b\u{e9}", "c\"d"])
+        }
+      }
+    }
+  }
+
+  func testConfigurationFileCaching() throws {
+    let url = FileManager.default.temporaryDirectory
+      .appendingPathComponent("ValueSourceEndToEndTests-\(UUID().uuidString).json")
+    defer { try? FileManager.default.removeItem(at: url) }
+    configurationPath = url.path
+
+    // A missing file isn't cached, so it's read once it exists.
+    AssertParse(Tool.self, []) { tool in
+      XCTAssertEqual(tool.jobs, 1)
+    }
+    try #"{ "jobs": 3 }"#.write(to: url, atomically: true, encoding: .utf8)
+    AssertParse(Tool.self, []) { tool in
+      XCTAssertEqual(tool.jobs, 3)
+    }
+  }
+
+  func testInvalidValues() throws {
+    configurationPath = "/nonexistent/value-source-test.json"
+    try withEnvironment(["JOBS": "many"]) {
+      AssertErrorMessage(Tool.self, [], "The value 'many' from environment variable VALUE_SOURCE_TEST_JOBS is invalid for '--jobs <jobs>'")
+    }
+    try withEnvironment(["VERBOSE": "maybe"]) {
+      AssertErrorMessage(Tool.self, [], "The value 'maybe' from environment variable VALUE_SOURCE_TEST_VERBOSE is invalid for '--verbose'")
+    }
+
+    try withConfiguration(#"{ "jobs": 2, }"#) {
+      XCTAssertThrowsError(try Tool.parse([]))
+    }
+    try withConfiguration(#"{ "jobs": { "nested": 1 } }"#) {
+      XCTAssertThrowsError(try Tool.parse([]))
+    }
+  }
+}
@@ -237,6 +237,7 @@ _math() {
     cur="${COMP_WORDS[COMP_CWORD]}"
     prev="${COMP_WORDS[COMP_CWORD-1]}"
     COMPREPLY=()
+    __math_start_completion_server
     opts="--version -h --help add multiply stats help --dump-help"
     if [[ $COMP_CWORD == "1" ]]; then
         COMPREPLY=( $(compgen -W "$opts" -- "$cur") )
@@ -325,7 +326,7 @@ _math_stats_stdev() {
 _math_stats_quantiles() {
     opts="--file --directory --shell --custom --version -h --help --dump-help"
     opts="$opts alphabet alligator branch braggart"
-    opts="$opts $("${COMP_WORDS[0]}" ---completion stats quantiles -- customArg "${COMP_WORDS[@]}")"
+    opts="$opts $(__math_completion_request "${COMP_WORDS[0]}" ---completion stats quantiles -- customArg "${COMP_WORDS[@]}")"
     if [[ $COMP_CWORD == "$1" ]]; then
         COMPREPLY=( $(compgen -W "$opts" -- "$cur") )
         return
@@ -344,7 +345,7 @@ _math_stats_quantiles() {
             return
         ;;
         --custom)
-            COMPREPLY=( $(compgen -W "$("${COMP_WORDS[0]}" ---completion stats quantiles -- --custom "${COMP_WORDS[@]}")" -- "$cur") )
+            COMPREPLY=( $(compgen -W "$(__math_completion_request "${COMP_WORDS[0]}" ---completion stats quantiles -- --custom "${COMP_WORDS[@]}")" -- "$cur") )
             return
         ;;
     esac
@@ -359,6 +360,25 @@ _math_help() {
     COMPREPLY=( $(compgen -W "$opts" -- "$cur") )
 }
 
+__math_start_completion_server() {
+    [[ -n $SWIFT_ARGUMENT_PARSER_COMPLETION_SERVER ]] || return
+    [[ -n $__math_server_out ]] && kill -0 "$__math_server_PID" 2>/dev/null && return
+    [[ -n $__math_server_out ]] && exec {__math_server_in}<&- {__math_server_out}>&-
+    { coproc __math_server { "${COMP_WORDS[0]}" ---completion-server 2>/dev/null; }; } 2>/dev/null
+    exec {__math_server_in}<&"${__math_server[0]}" {__math_server_out}>&"${__math_server[1]}"
+}
+__math_completion_request() {
+    if [[ -n $__math_server_out ]] && kill -0 "$__math_server_PID" 2>/dev/null; then
+        local count line
+        printf '%s\\0' "$(($# - 1))" "${@:2}" >&"$__math_server_out"
+        IFS= read -r count <&"$__math_server_in" || return
+        while (( count-- > 0 )) && IFS= read -r line <&"$__math_server_in"; do
+            printf '%s\\n' "$line"
+        done
+        return
+    fi
+    "$@"
+}
 
 complete -F _math math
 """
@@ -372,6 +392,7 @@ typeset -A opt_args
 _math() {
     integer ret=1
     local -a args
+    __math_start_completion_server
     args+=(
         '--version[Show the version.]'
         '(-h --help)'{-h,--help}'[Show help information.]'
@@ -515,12 +536,12 @@ _math_stats_quantiles() {
     local -a args
     args+=(
         ':one-of-four:(alphabet alligator branch braggart)'
-        ':custom-arg:{_custom_completion $_math_commandname ---completion stats quantiles -- customArg $words}'
+        ':custom-arg:{_custom_completion __math_completion_request $_math_commandname ---completion stats quantiles -- customArg $words}'
         ':values:'
         '--file:file:_files -g '"'"'*.txt *.md'"'"''
         '--directory:directory:_files -/'
         '--shell:shell:{local -a list; list=(${(f)"$(head -100 /usr/share/dict/words | tail -50)"}); _describe '''' list}'
-        '--custom:custom:{_custom_completion $_math_commandname ---completion stats quantiles -- --custom $words}'
+        '--custom:custom:{_custom_completion __math_completion_request $_math_commandname ---completion stats quantiles -- --custom $words}'
         '--version[Show the version.]'
         '(-h --help)'{-h,--help}'[Show help information.]'
         '(--dump-help)'{--dump-help}'[Dump help information.]'
@@ -548,6 +569,27 @@ _custom_completion() {
     local completions=("${(@f)$($*)}")
     _describe '' completions
 }
+__math_start_completion_server() {
+    [[ -n $SWIFT_ARGUMENT_PARSER_COMPLETION_SERVER ]] || return
+    [[ -n $__math_server_out ]] && kill -0 $__math_server_pid 2>/dev/null && return
+    [[ -n $__math_server_out ]] && exec {__math_server_in}<&- {__math_server_out}>&-
+    setopt local_options no_monitor no_notify
+    coproc $_math_commandname ---completion-server 2>/dev/null
+    __math_server_pid=$!
+    exec {__math_server_in}<&p {__math_server_out}>&p
+}
+__math_completion_request() {
+    if [[ -n $__math_server_out ]] && kill -0 $__math_server_pid 2>/dev/null; then
+        local count line
+        print -rN -- $(($# - 1)) "${@:2}" >&$__math_server_out
+        IFS= read -r count <&$__math_server_in || return
+        while (( count-- > 0 )) && IFS= read -r line <&$__math_server_in; do
+            print -r -- "$line"
+        done
+        return
+    fi
+    "$@"
+}
 
 _math
 """
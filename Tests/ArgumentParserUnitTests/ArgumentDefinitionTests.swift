@@ -0,0 +1,51 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+@testable import ArgumentParser
+
+final class ArgumentDefinitionTests: XCTestCase {
+}
+
+fileprivate struct Options: ParsableArguments {
+  @Option(help: "The name to use.", completion: .list(["a", "b"]))
+  var name: String = "none"
+}
+
+extension ArgumentDefinitionTests {
+  func testHelpDetails() throws {
+    let definition = try XCTUnwrap(ArgumentSet(Options.self).first)
+    XCTAssertEqual(definition.help.abstract, "The name to use.")
+    XCTAssertEqual(definition.help.defaultValue, "none")
+    XCTAssertEqual(definition.help.keys, [InputKey(rawValue: "name")])
+    guard case .list(let words) = definition.completion.kind else {
+      XCTFail("Unexpected completion kind")
+      return
+    }
+    XCTAssertEqual(words, ["a", "b"])
+  }
+
+  func testModifyingCopiedHelp() throws {
+    let original = try XCTUnwrap(ArgumentSet(Options.self).first)
+    var copy = original
+    copy.help.abstract = "Changed."
+    copy.help.defaultValue = nil
+    copy.completion = .directory
+    
+    XCTAssertEqual(copy.help.abstract, "Changed.")
+    XCTAssertNil(copy.help.defaultValue)
+    XCTAssertEqual(original.help.abstract, "The name to use.")
+    XCTAssertEqual(original.help.defaultValue, "none")
+    if case .list = original.completion.kind {} else {
+      XCTFail("Unexpected completion kind")
+    }
+  }
+}
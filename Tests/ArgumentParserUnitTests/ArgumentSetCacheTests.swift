@@ -0,0 +1,116 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+@testable import ArgumentParser
+
+final class ArgumentSetCacheTests: XCTestCase {
+}
+
+// MARK: -
+
+fileprivate struct Counted: ParsableCommand {
+  static var initCount = 0
+  static var cachesArgumentDefinitions: Bool { true }
+
+  @Flag var verbose = false
+  @Option var name: String = "none"
+
+  init() {
+    Counted.initCount += 1
+  }
+}
+
+fileprivate enum Mode: String, EnumerableFlag {
+  case fast, slow
+}
+
+fileprivate struct Exclusive: ParsableArguments {
+  static var cachesArgumentDefinitions: Bool { true }
+
+  @Flag var mode: Mode = .fast
+  @Flag(inversion: .prefixedNo, exclusivity: .exclusive) var color = true
+}
+
+fileprivate struct Uncached: ParsableArguments {
+  static var initCount = 0
+
+  @Option var name: String = "none"
+
+  init() {
+    Uncached.initCount += 1
+  }
+}
+
+fileprivate var nextIdentifier = 0
+
+fileprivate struct Unwrapped: ParsableArguments {
+  @Flag var verbose = false
+  var identifier: Int = {
+    nextIdentifier += 1
+    return nextIdentifier
+  }()
+}
+
+fileprivate var nextSeed = 0
+
+fileprivate struct ChangingDefault: ParsableArguments {
+  @Option var seed: Int = {
+    nextSeed += 1
+    return nextSeed
+  }()
+}
+
+extension ArgumentSetCacheTests {
+  func testReflectsOncePerType() throws {
+    _ = try Counted.parse([])
+    _ = Counted.helpMessage()
+    let count = Counted.initCount
+
+    for _ in 0..<5 {
+      _ = try Counted.parse(["--verbose", "--name", "foo"])
+      _ = Counted.helpMessage()
+    }
+    XCTAssertEqual(Counted.initCount, count)
+  }
+
+  func testReflectsEachTimeWithoutOptingIn() throws {
+    _ = try Uncached.parse([])
+    let count = Uncached.initCount
+
+    _ = try Uncached.parse(["--name", "foo"])
+    XCTAssertGreaterThan(Uncached.initCount, count)
+  }
+
+  func testRepeatedParsesOfExclusiveFlags() throws {
+    for _ in 0..<3 {
+      XCTAssertThrowsError(try Exclusive.parse(["--fast", "--slow"]))
+      XCTAssertThrowsError(try Exclusive.parse(["--color", "--no-color"]))
+
+      let exclusive = try Exclusive.parse(["--slow", "--slow", "--no-color"])
+      XCTAssertEqual(exclusive.mode, .slow)
+      XCTAssertEqual(exclusive.color, false)
+    }
+  }
+
+  func testPropertiesWithoutWrappersAreNotCached() throws {
+    let first = try Unwrapped.parse([])
+    let second = try Unwrapped.parse([])
+    XCTAssertNotEqual(first.identifier, second.identifier)
+  }
+
+  func testChangingDefaultsAreNotCached() throws {
+    let first = try ChangingDefault.parse([])
+    let second = try ChangingDefault.parse([])
+    XCTAssertNotEqual(first.seed, second.seed)
+    XCTAssertEqual(try ChangingDefault.parse(["--seed", "0"]).seed, 0)
+  }
+}
@@ -0,0 +1,131 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+#if compiler(>=5.6) && canImport(_Concurrency)
+
+import XCTest
+@testable import ArgumentParser
+
+final class AsyncParsableCommandTests: XCTestCase {
+}
+
+@available(macOS 10.15, macCatalyst 13, iOS 13, tvOS 13, watchOS 6, *)
+fileprivate struct Root: AsyncParsableCommand {
+  static var configuration = CommandConfiguration(
+    subcommands: [Fetch.self, Count.self, Slow.self])
+
+  static var log: [String] = []
+
+  struct Fetch: AsyncParsableCommand {
+    @Argument var names: [String] = []
+
+    mutating func run() async throws {
+      let fetched = await withTaskGroup(of: String.self) { group -> [String] in
+        for name in names {
+          group.addTask { name.uppercased() }
+        }
+        var results: [String] = []
+        for await result in group {
+          results.append(result)
+        }
+        return results
+      }
+      Root.log.append(contentsOf: fetched.sorted())
+    }
+  }
+
+  struct Count: ParsableCommand {
+    @Option var limit = 3
+
+    mutating func run() throws {
+      Root.log.append("count \(limit)")
+    }
+  }
+
+  struct Slow: AsyncParsableCommand {
+    mutating func run() async throws {
+      while true {
+        try Task.checkCancellation()
+        await Task.yield()
+      }
+    }
+  }
+}
+
+fileprivate struct SyncRoot: ParsableCommand {
+  static var configuration = CommandConfiguration(
+    commandName: "sync-root",
+    subcommands: [Root.Fetch.self, Root.Count.self])
+}
+
+@available(macOS 10.15, macCatalyst 13, iOS 13, tvOS 13, watchOS 6, *)
+extension AsyncParsableCommandTests {
+  func testAsyncSubcommandOfSyncRoot() throws {
+    XCTAssertThrowsError(try SyncRoot.validateIsSynchronous(SyncRoot.parseAsRoot(["fetch", "a"]))) { error in
+      XCTAssertEqual(SyncRoot.message(for: error), "'fetch' is an asynchronous command, so it can only be run when 'sync-root' is an AsyncParsableCommand and its main() is called with 'await'.")
+      XCTAssertEqual(SyncRoot.exitCode(for: error), .validationFailure)
+    }
+    XCTAssertNoThrow(try SyncRoot.validateIsSynchronous(SyncRoot.parseAsRoot(["count"])))
+  }
+
+  func testAsyncSubcommand() async throws {
+    Root.log = []
+    try await Root.run(Root.parseAsRoot(["fetch", "b", "a"]))
+    XCTAssertEqual(Root.log, ["A", "B"])
+  }
+
+  func testSyncSubcommandOfAsyncRoot() async throws {
+    Root.log = []
+    try await Root.run(Root.parseAsRoot(["count", "--limit", "5"]))
+    XCTAssertEqual(Root.log, ["count 5"])
+  }
+
+  func testAsyncRootWithoutRunShowsHelp() async throws {
+    do {
+      try await Root.run(Root.parseAsRoot([]))
+      XCTFail("Didn't throw a help request")
+    } catch let error as CleanExit {
+      XCTAssertEqual(Root.exitCode(for: error), .success)
+    }
+  }
+
+  func testSignalHandlersAreRestored() throws {
+    #if !os(Windows)
+    let task = Task<Void, Error> {}
+    let previous = signal(SIGINT, SIG_IGN)
+    defer { signal(SIGINT, previous) }
+
+    let cancellation = SignalCancellation()
+    cancellation.begin(cancelling: task)
+    cancellation.end()
+    // Replacing the handler returns the one that `end()` restored.
+    let restored = signal(SIGINT, SIG_IGN)
+    XCTAssertEqual(unsafeBitCast(restored, to: Int.self), unsafeBitCast(SIG_IGN, to: Int.self))
+    #endif
+  }
+
+  func testCancellation() async throws {
+    let cancellation = SignalCancellation()
+    let command = try Root.parseAsRoot(["slow"])
+    let task = Task {
+      try await Root.run(command, cancellation: cancellation)
+    }
+    task.cancel()
+    do {
+      try await task.value
+      XCTFail("Didn't throw CancellationError")
+    } catch is CancellationError {
+      XCTAssertNil(cancellation.receivedSignal)
+    }
+  }
+}
+
+#endif
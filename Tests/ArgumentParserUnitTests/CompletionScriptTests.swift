@@ -123,6 +123,120 @@ extension CompletionScriptTests {
   }
 }
 
+fileprivate final class SlowCompletionLog {
+  private let lock = NSLock()
+  private var running = 0
+  private(set) var calls = 0
+  private(set) var maximumRunning = 0
+  
+  func begin() {
+    lock.lock()
+    defer { lock.unlock() }
+    calls += 1
+    running += 1
+    maximumRunning = max(maximumRunning, running)
+  }
+  
+  func end() {
+    lock.lock()
+    defer { lock.unlock() }
+    running -= 1
+  }
+}
+
+fileprivate let slowCompletionLog = SlowCompletionLog()
+
+extension CompletionScriptTests {
+  struct Parent: ParsableCommand {
+    static var configuration = CommandConfiguration(subcommands: [Child.self])
+    
+    struct Child: ParsableCommand {
+      @Option(completion: .custom { _ in ["child"] })
+      var name: String
+      
+      @Option(completion: .custom(timeout: 0.2) { _, results in
+        results.append("fast")
+        results.append(contentsOf: ["also-fast"])
+        Thread.sleep(forTimeInterval: 5)
+        results.append("slow")
+      })
+      var remote: String
+      
+      @Option(completion: .custom(timeout: 5) { arguments, results in
+        results.append(contentsOf: arguments.reversed())
+      })
+      var echo: String
+      
+      @Option(completion: .custom(timeout: 0.1) { _, results in
+        slowCompletionLog.begin()
+        Thread.sleep(forTimeInterval: 0.5)
+        results.append("late")
+        slowCompletionLog.end()
+      })
+      var slow: String
+    }
+  }
+  
+  func customOutput(_ arguments: [String]) throws -> String? {
+    do {
+      _ = try Parent.parseAsRoot(arguments)
+    } catch let error as CommandError {
+      guard case .completionScriptCustomResponse(let output) = error.parserError else {
+        throw error
+      }
+      return output
+    }
+    return nil
+  }
+  
+  func testCustomCompletionsInSubcommand() throws {
+    XCTAssertEqual(try customOutput(["---completion", "child", "--", "--name"]), "child")
+    XCTAssertThrowsError(try customOutput(["---completion", "--", "--name"]))
+    XCTAssertThrowsError(try customOutput(["---completion", "missing", "--", "--name"]))
+  }
+  
+  func testCustomCompletionsWithTimeout() throws {
+    XCTAssertEqual(try customOutput(["---completion", "child", "--", "--remote"]), "fast\nalso-fast")
+    XCTAssertEqual(try customOutput(["---completion", "child", "--", "--echo", "a", "b"]), "b\na")
+  }
+  
+  func testTimedOutCompletionsDontPileUp() throws {
+    for _ in 0..<3 {
+      XCTAssertEqual(try customOutput(["---completion", "child", "--", "--slow"]), "")
+    }
+    // Other arguments aren't held up by the slow one.
+    XCTAssertEqual(try customOutput(["---completion", "child", "--", "--echo", "a"]), "a")
+    
+    Thread.sleep(forTimeInterval: 1)
+    XCTAssertEqual(slowCompletionLog.maximumRunning, 1)
+    // The later requests timed out while the first call was running, so
+    // they were skipped.
+    XCTAssertEqual(slowCompletionLog.calls, 1)
+  }
+  
+  func testCompletionServer() {
+    var input = [
+      "4", "---completion", "child", "--", "--name",
+      "5", "---completion", "child", "--", "--echo", "x\ny",
+      "3", "---completion", "--", "--name",
+      "not a count",
+      "6", "---completion", "child", "--", "--echo", "a", "b",
+    ][...]
+    var responses: [String] = []
+    CompletionServer(rootCommand: Parent.self).serve(
+      readRecord: { input.popFirst() },
+      write: { responses.append($0) })
+    
+    XCTAssertEqual(responses, [
+      "1\nchild\n",
+      "2\nx\ny\n",
+      "0\n",
+      "0\n",
+      "2\nb\na\n",
+    ])
+  }
+}
+
 extension CompletionScriptTests {
   struct EscapedCommand: ParsableCommand {
     @Option(help: #"Escaped chars: '[]\."#)
@@ -134,6 +248,94 @@ extension CompletionScriptTests {
   }
 }
 
+extension CompletionScriptTests {
+  struct Versioned: ParsableCommand {
+    static var configuration = CommandConfiguration(
+      commandName: "versioned-tool",
+      version: "1.2.0 (beta/3)")
+  }
+
+  func testCompletionShimCacheKey() {
+    XCTAssertEqual(CompletionShimGenerator.cacheKey(for: Versioned.self), "1.2.0__beta_3_")
+    XCTAssertEqual(CompletionShimGenerator.cacheKey(for: Base.self), "unversioned")
+  }
+
+  func testCompletionShims() throws {
+    let bash = Versioned.completionShim(for: .bash)
+    XCTAssertTrue(bash.contains("/swift-argument-parser/versioned-tool/1.2.0__beta_3_/versioned-tool.bash"))
+    XCTAssertTrue(bash.contains("--generate-completion-script bash"))
+    XCTAssertTrue(bash.contains("unset -f _versioned_tool_load_completions"))
+
+    let zsh = Versioned.completionShim(for: .zsh)
+    XCTAssertTrue(zsh.contains("/swift-argument-parser/versioned-tool/1.2.0__beta_3_/_versioned-tool"))
+    XCTAssertTrue(zsh.contains("compdef _versioned-tool versioned-tool"))
+
+    let fish = Versioned.completionShim(for: .fish)
+    XCTAssertTrue(fish.contains("/swift-argument-parser/versioned-tool/1.2.0__beta_3_/versioned-tool.fish"))
+    XCTAssertTrue(fish.contains("--generate-completion-script fish"))
+  }
+
+  func testCompletionShimRequest() throws {
+    for (arguments, expectedShell) in [(["--generate-completion-shim", "zsh"], "zsh"), (["--generate-completion-shim"], nil)] {
+      do {
+        _ = try Versioned.parseAsRoot(arguments)
+        XCTFail("Didn't error as expected")
+      } catch let error as CommandError {
+        guard case .completionShimRequested(let shell) = error.parserError else {
+          throw error
+        }
+        XCTAssertEqual(shell, expectedShell)
+      }
+    }
+
+    XCTAssertEqual(
+      Versioned.fullMessage(for: CommandError(commandStack: [Versioned.self], parserError: .completionShimRequested(shell: "fish"))),
+      Versioned.completionShim(for: .fish))
+  }
+}
+
+extension CompletionScriptTests {
+  struct Lazy: ParsableCommand {
+    static var configuration = CommandConfiguration(
+      subcommands: [Parent.self],
+      lazilyLoadsSubcommandCompletions: true)
+  }
+  
+  func lazyOutput(_ arguments: [String]) throws -> String? {
+    do {
+      _ = try Lazy.parseAsRoot(arguments)
+    } catch let error as CommandError {
+      guard case .completionScriptCustomResponse(let output) = error.parserError else {
+        throw error
+      }
+      return output
+    }
+    return nil
+  }
+  
+  func testLazySubcommandCompletions() throws {
+    for shell in [CompletionShell.bash, .zsh] {
+      let script = Lazy.completionScript(for: shell)
+      XCTAssertTrue(script.contains("---completion-function \(shell.rawValue) parent 2>/dev/null"))
+      XCTAssertFalse(script.contains("---completion-function \(shell.rawValue) parent child"))
+      XCTAssertFalse(script.contains("--name"))
+      
+      let parent = try XCTUnwrap(lazyOutput(["---completion-function", shell.rawValue, "parent"]))
+      XCTAssertTrue(parent.hasPrefix("_lazy_parent() {"))
+      XCTAssertTrue(parent.contains("---completion-function \(shell.rawValue) parent child 2>/dev/null"))
+      XCTAssertFalse(parent.contains("--name"))
+      
+      let child = try XCTUnwrap(lazyOutput(["---completion-function", shell.rawValue, "parent", "child"]))
+      XCTAssertTrue(child.hasPrefix("_lazy_parent_child() {"))
+      XCTAssertTrue(child.contains("--name"))
+    }
+    
+    XCTAssertThrowsError(try lazyOutput(["---completion-function", "fish", "parent"]))
+    XCTAssertThrowsError(try lazyOutput(["---completion-function", "bash"]))
+    XCTAssertThrowsError(try lazyOutput(["---completion-function", "bash", "missing"]))
+  }
+}
+
 private let zshBaseCompletions = """
 #compdef base
 local context state state_descr line
@@ -143,6 +345,7 @@ typeset -A opt_args
 _base() {
     integer ret=1
     local -a args
+    __base_start_completion_server
     args+=(
         '--name[The user'"'"'s name.]:name:'
         '--kind:kind:(one two custom-three)'
@@ -163,6 +366,27 @@ _custom_completion() {
     local completions=("${(@f)$($*)}")
     _describe '' completions
 }
+__base_start_completion_server() {
+    [[ -n $SWIFT_ARGUMENT_PARSER_COMPLETION_SERVER ]] || return
+    [[ -n $__base_server_out ]] && kill -0 $__base_server_pid 2>/dev/null && return
+    [[ -n $__base_server_out ]] && exec {__base_server_in}<&- {__base_server_out}>&-
+    setopt local_options no_monitor no_notify
+    coproc $_base_commandname ---completion-server 2>/dev/null
+    __base_server_pid=$!
+    exec {__base_server_in}<&p {__base_server_out}>&p
+}
+__base_completion_request() {
+    if [[ -n $__base_server_out ]] && kill -0 $__base_server_pid 2>/dev/null; then
+        local count line
+        print -rN -- $(($# - 1)) "${@:2}" >&$__base_server_out
+        IFS= read -r count <&$__base_server_in || return
+        while (( count-- > 0 )) && IFS= read -r line <&$__base_server_in; do
+            print -r -- "$line"
+        done
+        return
+    fi
+    "$@"
+}
 
 _base
 """
@@ -174,6 +398,7 @@ _base() {
     cur="${COMP_WORDS[COMP_CWORD]}"
     prev="${COMP_WORDS[COMP_CWORD-1]}"
     COMPREPLY=()
+    __base_start_completion_server
     opts="--name --kind --other-kind --path1 --path2 --path3 -h --help --dump-help"
     if [[ $COMP_CWORD == "1" ]]; then
         COMPREPLY=( $(compgen -W "$opts" -- "$cur") )
@@ -208,6 +433,25 @@ _base() {
     COMPREPLY=( $(compgen -W "$opts" -- "$cur") )
 }
 
+__base_start_completion_server() {
+    [[ -n $SWIFT_ARGUMENT_PARSER_COMPLETION_SERVER ]] || return
+    [[ -n $__base_server_out ]] && kill -0 "$__base_server_PID" 2>/dev/null && return
+    [[ -n $__base_server_out ]] && exec {__base_server_in}<&- {__base_server_out}>&-
+    { coproc __base_server { "${COMP_WORDS[0]}" ---completion-server 2>/dev/null; }; } 2>/dev/null
+    exec {__base_server_in}<&"${__base_server[0]}" {__base_server_out}>&"${__base_server[1]}"
+}
+__base_completion_request() {
+    if [[ -n $__base_server_out ]] && kill -0 "$__base_server_PID" 2>/dev/null; then
+        local count line
+        printf '%s\\0' "$(($# - 1))" "${@:2}" >&"$__base_server_out"
+        IFS= read -r count <&"$__base_server_in" || return
+        while (( count-- > 0 )) && IFS= read -r line <&"$__base_server_in"; do
+            printf '%s\\n' "$line"
+        done
+        return
+    fi
+    "$@"
+}
 
 complete -F _base base
 """
@@ -221,6 +465,7 @@ typeset -A opt_args
 _escaped-command() {
     integer ret=1
     local -a args
+    __escaped_command_start_completion_server
     args+=(
         '--one[Escaped chars: '"'"'\\[\\]\\\\.]:one:'
         '(-h --help)'{-h,--help}'[Show help information.]'
@@ -236,6 +481,27 @@ _custom_completion() {
     local completions=("${(@f)$($*)}")
     _describe '' completions
 }
+__escaped_command_start_completion_server() {
+    [[ -n $SWIFT_ARGUMENT_PARSER_COMPLETION_SERVER ]] || return
+    [[ -n $__escaped_command_server_out ]] && kill -0 $__escaped_command_server_pid 2>/dev/null && return
+    [[ -n $__escaped_command_server_out ]] && exec {__escaped_command_server_in}<&- {__escaped_command_server_out}>&-
+    setopt local_options no_monitor no_notify
+    coproc $_escaped_command_commandname ---completion-server 2>/dev/null
+    __escaped_command_server_pid=$!
+    exec {__escaped_command_server_in}<&p {__escaped_command_server_out}>&p
+}
+__escaped_command_completion_request() {
+    if [[ -n $__escaped_command_server_out ]] && kill -0 $__escaped_command_server_pid 2>/dev/null; then
+        local count line
+        print -rN -- $(($# - 1)) "${@:2}" >&$__escaped_command_server_out
+        IFS= read -r count <&$__escaped_command_server_in || return
+        while (( count-- > 0 )) && IFS= read -r line <&$__escaped_command_server_in; do
+            print -r -- "$line"
+        done
+        return
+    fi
+    "$@"
+}
 
 _escaped-command
 """
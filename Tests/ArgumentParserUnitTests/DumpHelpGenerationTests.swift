@@ -15,7 +15,9 @@ import ArgumentParserTestHelpers
 final class DumpHelpGenerationTests: XCTestCase {
   public static let allTests = [
     ("testDumpExampleCommands", testDumpExampleCommands),
-    ("testDumpA", testDumpA)
+    ("testDumpA", testDumpA),
+    ("testCompactDump", testCompactDump),
+    ("testReadingCompactDump", testReadingCompactDump),
   ]
 }
 
@@ -114,6 +116,53 @@ extension DumpHelpGenerationTests {
             """)
   }
   
+  struct B: ParsableCommand {
+    static var configuration = CommandConfiguration(
+      commandName: "b",
+      abstract: "Say \"hi\".",
+      subcommands: [C.self])
+    
+    @Flag(help: "Be loud.\nReally.")
+    var loud = false
+  }
+  
+  struct C: ParsableCommand {
+    @Argument var name: String?
+  }
+  
+  public func testCompactDump() throws {
+    let compact = B.compactDumpMessage()
+    XCTAssertFalse(compact.contains("\n"))
+    XCTAssertTrue(compact.hasPrefix(#"{"serializationVersion":1,"command":{"name":["b"],"abstract":"Say \"hi\".","discussion":""},"subcommands":[{"command":{"name":["c"],"#))
+    XCTAssertTrue(compact.contains(#""abstract":"Be loud.\nReally."#))
+    XCTAssertEqual(try HelpInfo(compactDump: compact), DumpHelpInfoGenerator(B.self).helpInfo)
+    
+    do {
+      _ = try B.parse(["--dump-help-compact"])
+      XCTFail()
+    } catch {
+      XCTAssertEqual(B.fullMessage(for: error), compact)
+    }
+  }
+  
+  public func testReadingCompactDump() throws {
+    let info = try HelpInfo(compactDump: """
+      { "serializationVersion": 1,
+        "future": [{ "nested": [1, true, null] }],
+        "command": { "name": null, "abstract": "A \\u00e9 \\\"b\\\"", "discussion": "", "isDefault": false },
+        "options": [] }
+      """)
+    XCTAssertEqual(info.command.name, nil)
+    XCTAssertEqual(info.command.abstract, "A é \"b\"")
+    XCTAssertEqual(info.command.isDefault, false)
+    XCTAssertEqual(info.options, [])
+    
+    XCTAssertThrowsError(try HelpInfo(compactDump: #"{"command":{"abstract":"","discussion":""}}"#))
+    XCTAssertThrowsError(try HelpInfo(compactDump: #"{"serializationVersion":2,"command":{"abstract":"","discussion":""}}"#))
+    XCTAssertThrowsError(try HelpInfo(compactDump: #"{"serializationVersion":1,"command":{"abstract":""}}"#))
+    XCTAssertThrowsError(try HelpInfo(compactDump: #"{"serializationVersion":1,"command":{"abstract":"","discussion":""}} {}"#))
+  }
+  
   public func testDumpExampleCommands() throws {
     struct TestCase {
       let expected: String
@@ -190,3 +190,70 @@ extension ErrorMessageTests {
       "Unknown option '--cont'. Did you mean '--count'?")
   }
 }
+
+// MARK: -
+
+fileprivate struct Tool: ParsableCommand {
+  static var configuration = CommandConfiguration(
+    subcommands: [Build.self, Bundle.self, Internal.self, Go.self])
+}
+
+fileprivate struct Build: ParsableCommand {}
+fileprivate struct Bundle: ParsableCommand {}
+fileprivate struct Go: ParsableCommand {}
+
+fileprivate struct Internal: ParsableCommand {
+  static var configuration = CommandConfiguration(shouldDisplay: false)
+}
+
+extension ErrorMessageTests {
+  func AssertRootErrorMessage(_ arguments: [String], _ errorMessage: String, file: StaticString = #file, line: UInt = #line) {
+    do {
+      _ = try Tool.parseAsRoot(arguments)
+      XCTFail("Parsing should have failed.", file: (file), line: line)
+    } catch {
+      XCTAssertEqual(Tool.message(for: error), errorMessage, file: (file), line: line)
+    }
+  }
+
+  func testMisspelledSubcommand() {
+    AssertRootErrorMessage(["buidl"], "Unknown subcommand 'buidl'. Did you mean 'build'?")
+    AssertRootErrorMessage(["bundel", "x"], "Unknown subcommand 'bundel'. Did you mean 'bundle'?")
+    AssertRootErrorMessage(["hepl"], "Unknown subcommand 'hepl'. Did you mean 'help'?")
+  }
+
+  func testUnrelatedExtraValues() {
+    AssertRootErrorMessage(["deploy"], "Unexpected argument 'deploy'")
+    AssertRootErrorMessage(["x"], "Unexpected argument 'x'")
+    AssertRootErrorMessage(["interal"], "Unexpected argument 'interal'")
+  }
+}
+
+// MARK: -
+
+fileprivate struct LazyGroupOptions: ParsableArguments {
+  @Option var target: String
+}
+
+fileprivate struct LazyRoot: ParsableCommand {
+  static var configuration = CommandConfiguration(commandName: "lazy-root", subcommands: [LazyChild.self])
+}
+
+fileprivate struct LazyChild: ParsableCommand {
+  static var configuration = CommandConfiguration(commandName: "child")
+  @OptionGroup(lazy: true) var options: LazyGroupOptions
+}
+
+extension ErrorMessageTests {
+  func testLazyOptionGroupErrors() throws {
+    let child = try XCTUnwrap(LazyRoot.parseAsRoot(["child"]) as? LazyChild)
+    let lazyValue = try XCTUnwrap(child._options._lazyValue)
+    XCTAssertTrue(lazyValue.rootCommand == LazyRoot.self)
+
+    XCTAssertThrowsError(try lazyValue.value()) { error in
+      XCTAssertTrue(error is CommandError)
+      XCTAssertEqual(LazyRoot.message(for: error), "Missing expected argument '--target <target>'")
+      XCTAssertTrue(LazyRoot.fullMessage(for: error).contains("Usage: lazy-root child --target <target>"))
+    }
+  }
+}
@@ -543,4 +543,59 @@ extension HelpGenerationTests {
 
       """)
   }
+
+  struct CachedModel: ParsableCommand {
+    static var cachesArgumentDefinitions: Bool { true }
+    
+    @Option(help: "The number of jobs.")
+    var jobs = 4
+  }
+  
+  func testHelpFormatsShareModel() {
+    let stack: [ParsableCommand.Type] = [H.self, H.AnotherCommand.self]
+    let model = HelpModel(commandStack: stack)
+    for width in [40, 80, 120] {
+      XCTAssertEqual(
+        HelpGenerator.rendered(commandStack: stack, screenWidth: width),
+        HelpGenerator(model: model).rendered(screenWidth: width))
+    }
+    XCTAssertNotEqual(
+      HelpGenerator.rendered(commandStack: stack, screenWidth: 40),
+      HelpGenerator.rendered(commandStack: stack, screenWidth: 120))
+    XCTAssertEqual(
+      DumpHelpInfoGenerator.rendered(commandStack: stack),
+      DumpHelpInfoGenerator(model: model).rendered())
+    
+    // Models are only reused for commands that opt in to caching their
+    // argument definitions.
+    XCTAssertFalse(HelpModel.model(for: stack) === HelpModel.model(for: stack))
+    XCTAssertTrue(HelpModel.model(for: [CachedModel.self]) === HelpModel.model(for: [CachedModel.self]))
+    XCTAssertEqual(
+      HelpGenerator.rendered(commandStack: [CachedModel.self], screenWidth: 80),
+      HelpGenerator(model: HelpModel(commandStack: [CachedModel.self])).rendered(screenWidth: 80))
+  }
+
+  struct ChunkedOutput: TextOutputStream {
+    var chunks: [String] = []
+    
+    mutating func write(_ string: String) {
+      chunks.append(string)
+    }
+  }
+  
+  func testWrittenHelpMatchesHelpMessage() {
+    var output = ChunkedOutput()
+    H.writeHelpMessage(to: &output, columns: 80)
+    XCTAssertGreaterThan(output.chunks.count, 1)
+    XCTAssertEqual(output.chunks.joined(), H.helpMessage(columns: 80))
+    
+    output = ChunkedOutput()
+    H.writeHelpMessage(for: H.AnotherCommand.self, to: &output, columns: 40)
+    XCTAssertEqual(output.chunks.joined(), H.helpMessage(for: H.AnotherCommand.self, columns: 40))
+    
+    output = ChunkedOutput()
+    MessageInfo(error: CommandError(commandStack: [H.self], parserError: .helpRequested), type: H.self)
+      .write(for: H.self, to: &output)
+    XCTAssertEqual(output.chunks.joined(), H.helpMessage() + "\n")
+  }
 }
@@ -31,3 +31,49 @@ extension InputOriginTests {
     Assert(elements: [.defaultValue, .argumentIndex(SplitArguments.Index(inputIndex: 1))], expectedIsDefaultValue: false)
   }
 }
+
+extension InputOriginTests {
+  private func index(_ i: Int, _ sub: Int? = nil) -> InputOrigin.Element {
+    .argumentIndex(SplitArguments.Index(
+      inputIndex: .init(rawValue: i),
+      subIndex: sub.map { .sub($0) } ?? .complete))
+  }
+  
+  func testElementsAreSortedAndUnique() {
+    let origin = InputOrigin(elements: [index(3), .defaultValue, index(1, 0), index(1), index(3), index(2)])
+    XCTAssertEqual(origin.elements, [index(1), index(1, 0), index(2), index(3), .defaultValue])
+    XCTAssertEqual(origin.first, index(1))
+    
+    var inserted = InputOrigin()
+    for element in [index(2), index(3), index(1), .defaultValue, index(1, 0), index(3)] {
+      inserted.insert(element)
+    }
+    XCTAssertEqual(inserted, origin)
+  }
+  
+  func testUnion() {
+    var a: InputOrigin = [index(1), index(5)]
+    a.formUnion([index(3)])
+    XCTAssertEqual(a.elements, [index(1), index(3), index(5)])
+    
+    var b: InputOrigin = [index(4)]
+    b.formUnion(a)
+    XCTAssertEqual(b.elements, [index(1), index(3), index(4), index(5)])
+    
+    var c = InputOrigin(elements: (10..<20).map { index($0) })
+    c.formUnion(InputOrigin(elements: (0..<15).map { index($0) }))
+    XCTAssertEqual(c.elements, (0..<20).map { index($0) })
+    
+    c.formUnion(InputOrigin())
+    XCTAssertEqual(c.elements.count, 20)
+    XCTAssertEqual(InputOrigin().inserting(index(1)), [index(1)])
+  }
+  
+  func testEquality() {
+    XCTAssertEqual(InputOrigin(), [])
+    XCTAssertEqual([index(1), index(2)] as InputOrigin, [index(2), index(1)])
+    XCTAssertNotEqual([index(1)] as InputOrigin, [index(1), index(2)])
+    XCTAssertTrue(InputOrigin().isEmpty)
+    XCTAssertFalse(InputOrigin(element: .defaultValue).isEmpty)
+  }
+}
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+@testable import ArgumentParser
+
+final class NameIndexTests: XCTestCase {
+}
+
+extension NameIndexTests {
+  func testLookup() {
+    let index = NameIndex([
+      (.short("v"), 0), (.long("verbose"), 0),
+      (.short("ü"), 1), (.longWithSingleDash("file"), 2),
+      (.long("output"), 3), (.short("v"), 4), (.long("output"), 5),
+    ])
+
+    XCTAssertEqual(index.position(of: .short("v")), 0)
+    XCTAssertEqual(index.position(of: .short("v", allowingJoined: true)), 0)
+    XCTAssertEqual(index.position(of: .long("verbose")), 0)
+    XCTAssertEqual(index.position(of: .short("ü")), 1)
+    XCTAssertEqual(index.position(of: .longWithSingleDash("file")), 2)
+    XCTAssertEqual(index.position(of: .long("output")), 3)
+
+    XCTAssertNil(index.position(of: .short("f")))
+    XCTAssertNil(index.position(of: .long("file")))
+    XCTAssertNil(index.position(of: .longWithSingleDash("verbose")))
+  }
+
+  func testEmpty() {
+    let index = NameIndex()
+    XCTAssertNil(index.position(of: .short("a")))
+    XCTAssertNil(index.position(of: .long("a")))
+    XCTAssertNil(index.position(ofLongNameWithPrefix: "a"))
+  }
+
+  func testInsert() {
+    var index = NameIndex([(.long("beta"), 0)])
+    index.insert(.long("alpha"), at: 1)
+    index.insert(.long("gamma"), at: 2)
+    index.insert(.long("alpha"), at: 3)
+    index.insert(.short("a"), at: 4)
+
+    XCTAssertEqual(index.position(of: .long("alpha")), 1)
+    XCTAssertEqual(index.position(of: .short("a")), 4)
+    XCTAssertEqual(index.position(ofLongNameWithPrefix: "al"), 1)
+    XCTAssertEqual(index.position(ofLongNameWithPrefix: "g"), 2)
+  }
+
+  func testPrefixes() {
+    let index = NameIndex([
+      (.long("verbose"), 0), (.long("version-file"), 1),
+      (.long("color"), 2), (.long("colour"), 2),
+      (.longWithSingleDash("quiet"), 3),
+    ])
+
+    XCTAssertEqual(index.position(ofLongNameWithPrefix: "verb"), 0)
+    XCTAssertEqual(index.position(ofLongNameWithPrefix: "vers"), 1)
+    XCTAssertEqual(index.position(ofLongNameWithPrefix: "verbose"), 0)
+    XCTAssertNil(index.position(ofLongNameWithPrefix: "ver"))
+    XCTAssertNil(index.position(ofLongNameWithPrefix: "verbosely"))
+
+    // Both names belong to the same argument.
+    XCTAssertEqual(index.position(ofLongNameWithPrefix: "col"), 2)
+
+    XCTAssertNil(index.position(ofLongNameWithPrefix: "q"))
+    XCTAssertNil(index.position(ofLongNameWithPrefix: ""))
+  }
+}
@@ -0,0 +1,88 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+@testable import ArgumentParser
+
+final class ParseTracingTests: XCTestCase {
+  override func tearDown() {
+    ParseTracing.tracer = nil
+    super.tearDown()
+  }
+}
+
+fileprivate final class RecordingTracer: ParseTracer {
+  var events: [String] = []
+
+  func phaseDidBegin(_ phase: ParsePhase, command: String) {
+    events.append("begin \(phase) \(command)")
+  }
+
+  func phaseDidEnd(_ phase: ParsePhase, command: String, duration: Double) {
+    XCTAssertGreaterThanOrEqual(duration, 0)
+    events.append("end \(phase) \(command)")
+  }
+}
+
+fileprivate struct Traced: ParsableCommand {
+  static var configuration = CommandConfiguration(subcommands: [Child.self])
+
+  @Flag var verbose = false
+
+  struct Child: ParsableCommand {
+    @Option var count: Int = 0
+  }
+}
+
+extension ParseTracingTests {
+  func testParsePhases() throws {
+    let tracer = RecordingTracer()
+    ParseTracing.tracer = tracer
+
+    _ = try Traced.parseAsRoot(["--verbose", "child", "--count", "2"])
+    let phases = tracer.events.filter {
+      // The one-time phases depend on which tests ran first.
+      !$0.contains("commandTree") && !$0.contains("argumentSet")
+    }
+    XCTAssertEqual(phases, [
+      "begin splitArguments traced",
+      "end splitArguments traced",
+      "begin parse traced",
+      "end parse traced",
+      "begin decode traced",
+      "end decode traced",
+      "begin validate traced",
+      "end validate traced",
+      "begin parse traced child",
+      "end parse traced child",
+      "begin decode traced child",
+      "end decode traced child",
+      "begin validate traced child",
+      "end validate traced child",
+    ])
+  }
+
+  func testHelpPhase() {
+    let tracer = RecordingTracer()
+    ParseTracing.tracer = tracer
+
+    _ = Traced.helpMessage(for: Traced.Child.self)
+    XCTAssertEqual(tracer.events.last, "end help traced child")
+  }
+
+  func testNoTracer() throws {
+    ParseTracing.tracer = nil
+    let result = traced(.parse, command: { XCTFail("Evaluated the command name"); return "" }()) {
+      42
+    }
+    XCTAssertEqual(result, 42)
+  }
+}
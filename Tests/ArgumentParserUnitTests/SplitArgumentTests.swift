@@ -93,6 +93,32 @@ final class SplitArgumentTests: XCTestCase {
     XCTAssertEqual(sut.originalInput, ["--abc=def"])
   }
   
+  func testAttachedValueIsSliceOfInput() throws {
+    let sut = try SplitArguments(arguments: ["--abc=d=é", "-xyz=ü"])
+    
+    XCTAssertEqual(sut.elements.count, 2)
+    AssertElementEqual(sut, at: 0, .option(.nameWithValue(.long("abc"), "d=é")))
+    AssertElementEqual(sut, at: 1, .option(.nameWithValue(.longWithSingleDash("xyz"), "ü")))
+    
+    guard case .option(let parsed) = sut.elements[sut.elements.startIndex].value else {
+      return XCTFail("Expected an option")
+    }
+    XCTAssertEqual(parsed.value, "d=é")
+  }
+  
+  func testNonASCIINames() throws {
+    let sut = try SplitArguments(arguments: ["--naïve=1", "-éa", "--a=\u{301}b", "-\u{301}"])
+    
+    XCTAssertEqual(sut.elements.count, 6)
+    AssertElementEqual(sut, at: 0, .option(.nameWithValue(.long("naïve"), "1")))
+    AssertElementEqual(sut, at: 1, .option(.name(.longWithSingleDash("éa"))))
+    AssertElementEqual(sut, at: 2, .option(.name(.short("é"))))
+    AssertElementEqual(sut, at: 3, .option(.name(.short("a"))))
+    // The combining accent makes `=\u{301}` a single character.
+    AssertElementEqual(sut, at: 4, .option(.name(.long("a=\u{301}b"))))
+    AssertElementEqual(sut, at: 5, .value("-\u{301}"))
+  }
+  
   func testMultipleShortOptionsCombined() throws {
     let sut = try SplitArguments(arguments: ["-abc"])
     
@@ -419,9 +445,47 @@ extension SplitArgumentTests {
       sutB.remove(at: SplitArguments.Index(inputIndex: 0, subIndex: .sub(1)))
       
       XCTAssertEqual(sutB.elements.count, 1)
-      AssertIndexEqual(sutB, at: 2, inputIndex: 0, subIndex: .sub(0))
-      AssertElementEqual(sutB, at: 2, .option(.name(.short("f"))))
+      AssertIndexEqual(sutB, at: 1, inputIndex: 0, subIndex: .sub(0))
+      AssertElementEqual(sutB, at: 1, .option(.name(.short("f"))))
+    }
+  }
+  
+  func testRemovingEachShortNameInPack() throws {
+    for arg in ["-vvxzf", "-vväzf"] {
+      var sut = try SplitArguments(arguments: [arg])
+      XCTAssertEqual(sut.elements.count, 6)
+      
+      // Remove the short names out of order:
+      for sub in [3, 0, 4, 1] {
+        sut.remove(at: SplitArguments.Index(inputIndex: 0, subIndex: .sub(sub)))
+      }
+      XCTAssertEqual(sut.elements.count, 1)
+      AssertIndexEqual(sut, at: 3, inputIndex: 0, subIndex: .sub(2))
+      AssertElementEqual(sut, at: 3, .option(.name(.short(Array(arg)[3]))))
+      
+      sut.remove(at: SplitArguments.Index(inputIndex: 0, subIndex: .sub(2)))
+      XCTAssertEqual(sut.elements.count, 0)
+    }
+  }
+  
+  func testRemovingManyValues() throws {
+    let arguments = (0..<1000).map { "value-\($0)" } + ["-ab"]
+    var sut = try SplitArguments(arguments: arguments)
+    XCTAssertEqual(sut.elements.count, 1003)
+    
+    // Remove every odd input, in reverse order:
+    for i in stride(from: 999, to: 0, by: -2) {
+      sut.remove(at: SplitArguments.Index(inputIndex: .init(rawValue: i)))
     }
+    sut.remove(at: SplitArguments.Index(inputIndex: 1000, subIndex: .sub(0)))
+    XCTAssertEqual(sut.elements.count, 501)
+    
+    let extras = sut.coalescedExtraElements()
+    XCTAssertEqual(extras.count, 501)
+    XCTAssertEqual(extras.first?.1, "value-0")
+    XCTAssertEqual(extras.dropLast().last?.1, "value-998")
+    XCTAssertEqual(extras.last?.1, "-b")
+    XCTAssertEqual(extras.last?.0, [.argumentIndex(SplitArguments.Index(inputIndex: 1000, subIndex: .sub(1)))])
   }
 }
 
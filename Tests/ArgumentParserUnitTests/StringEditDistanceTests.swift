@@ -23,5 +23,25 @@ extension StringEditDistanceTests {
     XCTAssertEqual("bar".editDistance(to: "foo"), 3)
     XCTAssertEqual("bar".editDistance(to: "baz"), 1)
     XCTAssertEqual("baz".editDistance(to: "bar"), 1)
+    XCTAssertEqual("kitten".editDistance(to: "sitting"), 3)
+    XCTAssertEqual("café".editDistance(to: "cafe"), 1)
+  }
+  
+  func testBoundedEditDistance() {
+    XCTAssertEqual("kitten".editDistance(to: "sitting", maximum: 3), 3)
+    XCTAssertNil("kitten".editDistance(to: "sitting", maximum: 2))
+    XCTAssertEqual("bar".editDistance(to: "bar", maximum: 0), 0)
+    XCTAssertNil("bar".editDistance(to: "baz", maximum: 0))
+    XCTAssertNil("a".editDistance(to: "abcde", maximum: 3))
+    XCTAssertEqual("".editDistance(to: "abc", maximum: 3), 3)
+    XCTAssertNil("--verbose".editDistance(to: "--output-directory", maximum: 3))
+  }
+  
+  func testClosestMatch() {
+    let candidates = ["--name", "--nome", "--count", "--title"]
+    XCTAssertEqual("--nme".closestMatch(in: candidates, maximumDistance: 3), "--name")
+    XCTAssertEqual("--cout".closestMatch(in: candidates, maximumDistance: 3), "--count")
+    XCTAssertNil("--not-similar".closestMatch(in: candidates, maximumDistance: 3))
+    XCTAssertNil("--nme".closestMatch(in: [String](), maximumDistance: 3))
   }
 }
@@ -164,4 +164,43 @@ extension StringWrappingTests {
                       }
             """)
   }
+
+  func testFirstLineIndent() {
+    XCTAssertEqual("aaa bbb ccc".wrapped(to: 10, wrappingIndent: 4, firstLineIndent: 1), """
+             aaa
+                bbb
+                ccc
+            """)
+  }
+
+  func testNonASCII() {
+    XCTAssertEqual("café crème brûlée".wrapped(to: 11), """
+            café crème
+            brûlée
+            """)
+    XCTAssertEqual("café crème brûlée".wrapped(to: 13, wrappingIndent: 2), """
+              café crème
+              brûlée
+            """)
+  }
+
+  func testWideCharacters() {
+    XCTAssertEqual("日本語 テキスト".wrapped(to: 8), """
+            日本語
+            テキスト
+            """)
+    XCTAssertEqual("日本語 テキスト".wrapped(to: 9), """
+            日本語
+            テキスト
+            """)
+    XCTAssertEqual("日本語 テキスト".wrapped(to: 16), "日本語 テキスト")
+  }
+
+  func testNarrowColumns() {
+    XCTAssertEqual("one two".wrapped(to: 4, wrappingIndent: 6), """
+                  one
+                  two
+            """)
+  }
 }
+
@@ -70,3 +70,85 @@ extension TreeTests {
     XCTAssertThrowsError(try Tree(root: Root.asCommand))
   }
 }
+
+extension TreeTests {
+  struct Parent: ParsableCommand {
+    static let configuration = CommandConfiguration(subcommands: [Child.self])
+  }
+  struct Child: ParsableCommand {}
+  
+  func testCommandTreeIsShared() {
+    let tree = CommandParser(Parent.self).commandTree
+    XCTAssertTrue(tree === CommandParser(Parent.self).commandTree)
+    
+    // The `help` subcommand is only added once.
+    XCTAssertEqual(tree.children.count, 2)
+    XCTAssertTrue(tree.children.last?.element == HelpCommand.self)
+    XCTAssertTrue(CommandParser(Child.self).commandTree.isLeaf)
+  }
+}
+
+extension TreeTests {
+  struct Named: ParsableCommand {
+    static let configuration = CommandConfiguration(
+      subcommands: [First.self, Second.self, SecondCommand.self])
+  }
+  struct First: ParsableCommand {}
+  struct Second: ParsableCommand {}
+  struct SecondCommand: ParsableCommand {
+    static let configuration = CommandConfiguration(commandName: "second")
+  }
+  
+  func testFirstChildWithName() throws {
+    let tree = try Tree(root: Named.asCommand)
+    XCTAssertTrue(tree.firstChild(withName: "first")?.element == First.self)
+    XCTAssertTrue(tree.firstChild(withName: "second")?.element == Second.self)
+    XCTAssertNil(tree.firstChild(withName: "second-command"))
+    XCTAssertNil(tree.firstChild(withName: "named"))
+  }
+}
+
+fileprivate var configuredCommands: [String] = []
+
+extension TreeTests {
+  struct LazyRoot: ParsableCommand {
+    static var configuration: CommandConfiguration {
+      configuredCommands.append("root")
+      return CommandConfiguration(commandName: "root", subcommands: [Group.self, Leaf.self])
+    }
+  }
+  struct Group: ParsableCommand {
+    static var configuration: CommandConfiguration {
+      configuredCommands.append("group")
+      return CommandConfiguration(commandName: "group", subcommands: [Nested.self])
+    }
+  }
+  struct Leaf: ParsableCommand {
+    static var configuration: CommandConfiguration {
+      configuredCommands.append("leaf")
+      return CommandConfiguration(commandName: "leaf")
+    }
+  }
+  struct Nested: ParsableCommand {
+    static var configuration: CommandConfiguration {
+      configuredCommands.append("nested")
+      return CommandConfiguration(commandName: "nested")
+    }
+  }
+  
+  func testLazilyBuiltTree() {
+    configuredCommands = []
+    let tree = Tree<ParsableCommand.Type>.lazilyBuilt(root: LazyRoot.self)
+    XCTAssertEqual(configuredCommands, [])
+    
+    // Finding a child only builds the children of the nodes on the way.
+    let leaf = tree.firstChild(withName: "leaf")
+    XCTAssertTrue(leaf?.element == Leaf.self)
+    XCTAssertFalse(configuredCommands.contains("nested"))
+    
+    let nested = tree.firstChild(withName: "group")?.firstChild(withName: "nested")
+    XCTAssertTrue(nested?.element == Nested.self)
+    XCTAssertTrue(nested?.parent?.element == Group.self)
+    XCTAssertEqual(tree.children.map { $0.element._commandName }, ["group", "leaf"])
+  }
+}
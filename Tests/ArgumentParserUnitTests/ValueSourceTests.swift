@@ -0,0 +1,49 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+@testable import ArgumentParser
+
+final class ValueSourceTests: XCTestCase {
+}
+
+fileprivate var resolveCount = 0
+
+fileprivate struct Tool: ParsableCommand {
+  static var configuration = CommandConfiguration(valueSources: [
+    ValueSource {
+      resolveCount += 1
+      return { name in name == "jobs" ? (["2"], "test source") : nil }
+    },
+  ])
+
+  @Option var jobs: Int = 1
+  @Option var name: String?
+  @Flag var verbose = false
+}
+
+extension ValueSourceTests {
+  func testSourceIsResolvedOncePerParse() throws {
+    resolveCount = 0
+    let tool = try Tool.parse([])
+    XCTAssertEqual(tool.jobs, 2)
+    XCTAssertEqual(resolveCount, 1)
+
+    _ = try Tool.parse(["--name", "a"])
+    XCTAssertEqual(resolveCount, 2)
+  }
+
+  func testSourceIsNotResolvedWhenUnneeded() throws {
+    resolveCount = 0
+    _ = try Tool.parse(["--jobs", "3", "--name", "a", "--verbose"])
+    XCTAssertEqual(resolveCount, 0)
+  }
+}
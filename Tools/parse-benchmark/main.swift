@@ -0,0 +1,464 @@
+//===----------------------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Argument Parser open source project
+//
+// Copyright (c) 2021 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import ArgumentParser
+import Dispatch
+import Foundation
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#endif
+
+// MARK: Measurement
+
+/// A snapshot of the process's memory usage.
+struct MemorySnapshot {
+  /// The number of bytes currently allocated on the heap, if available.
+  var heapBytes: Int?
+
+  /// The number of blocks currently allocated on the heap, if available.
+  var heapBlocks: Int?
+
+  /// The peak resident set size of the process, in bytes, if available.
+  var peakResidentBytes: Int?
+
+  static func current() -> MemorySnapshot {
+    var snapshot = MemorySnapshot()
+
+    #if canImport(Glibc)
+    // `mallinfo()` is deprecated, and its `int` fields wrap above 2 GB, while
+    // `mallinfo2()` only exists in glibc 2.33 and later. `malloc_info()`
+    // reports sizes in full on every version, but not block counts.
+    snapshot.heapBytes = linuxHeapBytes()
+    #elseif canImport(Darwin)
+    var stats = malloc_statistics_t()
+    malloc_zone_statistics(nil, &stats)
+    snapshot.heapBytes = Int(stats.size_in_use)
+    snapshot.heapBlocks = Int(stats.blocks_in_use)
+    #endif
+
+    #if canImport(Glibc)
+    snapshot.peakResidentBytes = linuxPeakResidentBytes()
+    #elseif canImport(Darwin)
+    var usage = rusage()
+    if getrusage(RUSAGE_SELF, &usage) == 0 {
+      // Darwin reports `ru_maxrss` in bytes.
+      snapshot.peakResidentBytes = Int(usage.ru_maxrss)
+    }
+    #endif
+
+    return snapshot
+  }
+}
+
+#if canImport(Glibc)
+/// Returns the number of bytes allocated on the heap, computed from the
+/// totals that `malloc_info()` reports for all arenas: the memory that
+/// the arenas hold, less their free chunks, plus the chunks that are mapped
+/// separately.
+func linuxHeapBytes() -> Int? {
+  var buffer: UnsafeMutablePointer<CChar>?
+  var size = 0
+  guard let stream = open_memstream(&buffer, &size) else { return nil }
+  let status = malloc_info(0, stream)
+  fclose(stream)
+  guard let xml = buffer.map({ String(cString: $0) }) else { return nil }
+  free(buffer)
+  guard status == 0 else { return nil }
+
+  // The totals for all arenas follow the per-arena elements, so the last
+  // element of each kind is the one for the whole process.
+  func lastSize(of element: String) -> Int? {
+    guard let range = xml.range(of: element, options: .backwards) else { return nil }
+    let rest = xml[range.upperBound...]
+    guard let sizeRange = rest.range(of: "size=\"") else { return nil }
+    return Int(rest[sizeRange.upperBound...].prefix(while: { $0.isNumber }))
+  }
+
+  guard let arenas = lastSize(of: "<system type=\"current\""),
+    let fast = lastSize(of: "<total type=\"fast\""),
+    let rest = lastSize(of: "<total type=\"rest\""),
+    let mapped = lastSize(of: "<total type=\"mmap\"")
+  else { return nil }
+  return arenas - fast - rest + mapped
+}
+
+/// Reads the peak resident set size (`VmHWM`) from `/proc/self/status`.
+func linuxPeakResidentBytes() -> Int? {
+  guard let file = fopen("/proc/self/status", "r") else { return nil }
+  defer { fclose(file) }
+
+  var buffer = [CChar](repeating: 0, count: 256)
+  while fgets(&buffer, Int32(buffer.count), file) != nil {
+    let line = String(cString: buffer)
+    guard line.hasPrefix("VmHWM:") else { continue }
+    let kilobytes = line.dropFirst("VmHWM:".count).filter { $0.isNumber }
+    return Int(kilobytes).map { $0 * 1024 }
+  }
+  return nil
+}
+#endif
+
+struct BenchmarkResult {
+  var name: String
+  var iterations: Int
+  var elapsedNanoseconds: UInt64
+  var heapGrowth: Int?
+  var blockGrowth: Int?
+
+  var nanosecondsPerIteration: Double {
+    Double(elapsedNanoseconds) / Double(iterations)
+  }
+
+  var iterationsPerSecond: Double {
+    1_000_000_000 / nanosecondsPerIteration
+  }
+}
+
+struct Benchmark {
+  var name: String
+  var abstract: String
+
+  /// The number of iterations to run, relative to the requested iteration
+  /// count, for benchmarks that are much slower or faster than the others.
+  var scale: Double = 1
+
+  var body: () throws -> Void
+
+  /// Runs the benchmark repeatedly in this process, after warming up any
+  /// caches that it fills.
+  func run(iterations requested: Int) throws -> BenchmarkResult {
+    let iterations = max(1, Int(Double(requested) * scale))
+
+    // Warm up any caches before measuring.
+    try body()
+    return try measure(iterations: iterations)
+  }
+
+  /// Runs the benchmark `iterations` times and measures the result.
+  func measure(iterations: Int) throws -> BenchmarkResult {
+    let memoryBefore = MemorySnapshot.current()
+    let start = DispatchTime.now().uptimeNanoseconds
+    for _ in 0..<iterations {
+      try body()
+    }
+    let end = DispatchTime.now().uptimeNanoseconds
+    let memoryAfter = MemorySnapshot.current()
+
+    func growth(_ value: KeyPath<MemorySnapshot, Int?>) -> Int? {
+      memoryAfter[keyPath: value].flatMap { after in
+        memoryBefore[keyPath: value].map { after - $0 }
+      }
+    }
+    return BenchmarkResult(
+      name: name,
+      iterations: iterations,
+      elapsedNanoseconds: end - start,
+      heapGrowth: growth(\.heapBytes),
+      blockGrowth: growth(\.heapBlocks))
+  }
+
+  /// Runs the benchmark once in each of `samples` new processes, so that
+  /// every sample includes building the command tree, reflecting over the
+  /// commands, and rendering help from scratch.
+  func runCold(samples: Int) throws -> BenchmarkResult {
+    let executable = Bundle.main.executableURL
+      ?? URL(fileURLWithPath: CommandLine.arguments[0])
+    var total = BenchmarkResult(
+      name: name, iterations: samples, elapsedNanoseconds: 0,
+      heapGrowth: 0, blockGrowth: 0)
+
+    for _ in 0..<samples {
+      let process = Process()
+      let output = Pipe()
+      process.executableURL = executable
+      process.arguments = ["--cold-sample", name]
+      process.standardOutput = output
+      try process.run()
+      let data = output.fileHandleForReading.readDataToEndOfFile()
+      process.waitUntilExit()
+
+      let fields = String(decoding: data, as: UTF8.self)
+        .split(separator: " ")
+        .map { Int($0.trimmingCharacters(in: .whitespacesAndNewlines)) }
+      guard process.terminationStatus == 0, fields.count == 3,
+        let elapsed = fields[0]
+      else {
+        throw ValidationError("The cold sample for '\(name)' failed.")
+      }
+      total.elapsedNanoseconds += UInt64(elapsed)
+      total.heapGrowth = total.heapGrowth.flatMap { sum in fields[1].map { sum + $0 } }
+      total.blockGrowth = total.blockGrowth.flatMap { sum in fields[2].map { sum + $0 } }
+    }
+    return total
+  }
+}
+
+// MARK: Commands under test
+
+/// A command with a large number of flat options.
+struct FlatOptions: ParsableCommand {
+  @Option(help: "Option 0.") var option0: String = ""
+  @Option(help: "Option 1.") var option1: String = ""
+  @Option(help: "Option 2.") var option2: String = ""
+  @Option(help: "Option 3.") var option3: String = ""
+  @Option(help: "Option 4.") var option4: String = ""
+  @Option(help: "Option 5.") var option5: String = ""
+  @Option(help: "Option 6.") var option6: String = ""
+  @Option(help: "Option 7.") var option7: String = ""
+  @Option(help: "Option 8.") var option8: String = ""
+  @Option(help: "Option 9.") var option9: String = ""
+  @Option(help: "Option 10.") var option10: Int = 0
+  @Option(help: "Option 11.") var option11: Int = 0
+  @Option(help: "Option 12.") var option12: Int = 0
+  @Option(help: "Option 13.") var option13: Int = 0
+  @Option(help: "Option 14.") var option14: Int = 0
+  @Option(help: "Option 15.") var option15: Int = 0
+  @Option(help: "Option 16.") var option16: Int = 0
+  @Option(help: "Option 17.") var option17: Int = 0
+  @Option(help: "Option 18.") var option18: Int = 0
+  @Option(help: "Option 19.") var option19: Int = 0
+  @Option(help: "Option 20.") var option20: Double = 0
+  @Option(help: "Option 21.") var option21: Double = 0
+  @Option(help: "Option 22.") var option22: Double = 0
+  @Option(help: "Option 23.") var option23: Double = 0
+  @Option(help: "Option 24.") var option24: Double = 0
+  @Option(help: "Option 25.") var option25: Double = 0
+  @Option(help: "Option 26.") var option26: Double = 0
+  @Option(help: "Option 27.") var option27: Double = 0
+  @Option(help: "Option 28.") var option28: Double = 0
+  @Option(help: "Option 29.") var option29: Double = 0
+  @Flag(help: "Flag 0.") var flag0 = false
+  @Flag(help: "Flag 1.") var flag1 = false
+  @Flag(help: "Flag 2.") var flag2 = false
+  @Flag(help: "Flag 3.") var flag3 = false
+  @Flag(help: "Flag 4.") var flag4 = false
+  @Flag(help: "Flag 5.") var flag5 = false
+  @Flag(help: "Flag 6.") var flag6 = false
+  @Flag(help: "Flag 7.") var flag7 = false
+  @Flag(help: "Flag 8.") var flag8 = false
+  @Flag(help: "Flag 9.") var flag9 = false
+
+  static let arguments: [String] = (0..<30).flatMap { i -> [String] in
+    ["--option\(i)", i < 10 ? "value\(i)" : "\(i)"]
+  } + (0..<10).map { "--flag\($0)" }
+}
+
+/// A command that collects every positional value.
+struct Positionals: ParsableCommand {
+  @Flag var verbose = false
+  @Argument var files: [String] = []
+
+  static let arguments = ["--verbose"] + (0..<100_000).map { "file-\($0).txt" }
+}
+
+/// A command with an array option that is repeated many times.
+struct RepeatedOptions: ParsableCommand {
+  @Option(name: [.short, .long]) var define: [String] = []
+
+  static let arguments = (0..<10_000).flatMap { ["--define", "key\($0)=value\($0)"] }
+}
+
+/// A command with a pack of short flags.
+struct PackedFlags: ParsableCommand {
+  @Flag(name: .short) var a = false
+  @Flag(name: .short) var b = false
+  @Flag(name: .short) var c = false
+  @Flag(name: .short) var d = false
+  @Flag(name: .short) var e = false
+  @Flag(name: .short) var f = false
+  @Flag(name: .short) var g = false
+  @Option(name: .short) var output: String = ""
+
+  static let arguments = ["-abcdefg", "-o", "out.txt"]
+}
+
+/// The last command in a deep chain of subcommands.
+struct Leaf: ParsableCommand {
+  @Option var name: String = ""
+  @Flag var force = false
+}
+
+/// A command whose only subcommand is `Child`, for building deep trees from
+/// nested generic types.
+struct Level<Child: ParsableCommand>: ParsableCommand {
+  static var configuration: CommandConfiguration {
+    CommandConfiguration(commandName: "level", subcommands: [Child.self])
+  }
+
+  @Flag var verbose = false
+}
+
+typealias DeepTree = Level<Level<Level<Level<Level<Level<Level<Level<Level<Level<Leaf>>>>>>>>>>
+
+// The root command isn't named in the arguments, so only nine `level`
+// subcommands appear before `leaf`.
+let deepTreeArguments = Array(repeating: "level", count: 9) + ["leaf", "--name", "x", "--force"]
+
+// MARK: Benchmarks
+
+let benchmarks: [Benchmark] = [
+  Benchmark(name: "flat-options", abstract: "Parse 30 options and 10 flags.") {
+    _ = try FlatOptions.parseAsRoot(FlatOptions.arguments)
+  },
+  Benchmark(name: "positionals", abstract: "Parse 100,000 positional values.", scale: 0.01) {
+    _ = try Positionals.parseAsRoot(Positionals.arguments)
+  },
+  Benchmark(name: "repeated-options", abstract: "Parse an array option repeated 10,000 times.", scale: 0.01) {
+    _ = try RepeatedOptions.parseAsRoot(RepeatedOptions.arguments)
+  },
+  Benchmark(name: "packed-flags", abstract: "Parse a pack of seven short flags.") {
+    _ = try PackedFlags.parseAsRoot(PackedFlags.arguments)
+  },
+  Benchmark(name: "deep-subcommands", abstract: "Parse a subcommand nested 11 levels deep.") {
+    _ = try DeepTree.parseAsRoot(deepTreeArguments)
+  },
+  Benchmark(name: "help", abstract: "Render the help screen for a large command.", scale: 0.1) {
+    _ = FlatOptions.helpMessage(columns: 80)
+  },
+  Benchmark(name: "usage-error", abstract: "Render the error message for an unknown option.", scale: 0.1) {
+    do {
+      _ = try FlatOptions.parseAsRoot(["--optoin1", "x"])
+    } catch {
+      _ = FlatOptions.fullMessage(for: error)
+    }
+  },
+  Benchmark(name: "dump-help", abstract: "Render the JSON help dump for a deep tree.", scale: 0.01) {
+    _ = DeepTree.dumpMessage()
+  },
+  Benchmark(name: "completion-scripts", abstract: "Generate bash, zsh, and fish completion scripts.", scale: 0.01) {
+    for shell in CompletionShell.allCases {
+      _ = DeepTree.completionScript(for: shell)
+    }
+  },
+]
+
+// MARK: Command
+
+struct ParseBenchmark: ParsableCommand {
+  static var configuration: CommandConfiguration {
+    CommandConfiguration(
+      commandName: "parse-benchmark",
+      abstract: "Measures the performance of parsing and generating help.",
+      discussion: """
+        Each benchmark runs once to warm up, and then runs the requested
+        number of iterations. Slow benchmarks run a fraction of the
+        requested iterations. Heap growth is the change in allocated bytes
+        across the measured iterations, and block growth is the change in
+        the number of allocated blocks, where the platform reports them.
+
+        With --cold, each benchmark instead runs once in each of a number of
+        new processes, so that the measurements include building the
+        command tree, reflecting over the commands, and rendering help
+        without any caches. Heap and block growth are then the totals over
+        all of the samples.
+        """)
+  }
+
+  @Option(name: .shortAndLong, help: "The base number of iterations for each benchmark.")
+  var iterations: Int = 1000
+
+  @Flag(help: "Measure each sample in a new process, before any caches are filled.")
+  var cold = false
+
+  @Option(help: "The number of processes to run for each benchmark with --cold.")
+  var samples: Int = 20
+
+  @Option(help: .hidden)
+  var coldSample: String?
+
+  @Flag(help: "List the available benchmarks.")
+  var list = false
+
+  @Argument(help: "The benchmarks to run. Runs every benchmark by default.")
+  var names: [String] = []
+
+  func validate() throws {
+    guard iterations > 0 else {
+      throw ValidationError("Please specify a positive number of iterations.")
+    }
+    guard samples > 0 else {
+      throw ValidationError("Please specify a positive number of samples.")
+    }
+
+    let unknown = (names + (coldSample.map { [$0] } ?? [])).filter { name in !benchmarks.contains(where: { $0.name == name }) }
+    guard unknown.isEmpty else {
+      throw ValidationError("Unknown benchmark(s): \(unknown.joined(separator: ", "))")
+    }
+  }
+
+  func format(_ value: Double) -> String {
+    let rounded = (value * 10).rounded() / 10
+    return "\(rounded)"
+  }
+
+  func padded(_ string: String, to width: Int) -> String {
+    string.count >= width
+      ? string
+      : string + String(repeating: " ", count: width - string.count)
+  }
+
+  mutating func run() throws {
+    if let name = coldSample {
+      // Runs in a process started by `Benchmark.runCold(samples:)`, and
+      // reports a single measurement on standard output.
+      let benchmark = benchmarks.first(where: { $0.name == name })!
+
+      // Build the input arrays first, so that only the library's work is
+      // measured.
+      _ = FlatOptions.arguments.count + Positionals.arguments.count
+        + RepeatedOptions.arguments.count + PackedFlags.arguments.count
+      let result = try benchmark.measure(iterations: 1)
+      print(result.elapsedNanoseconds,
+            result.heapGrowth.map { "\($0)" } ?? "-",
+            result.blockGrowth.map { "\($0)" } ?? "-")
+      return
+    }
+
+    if list {
+      for benchmark in benchmarks {
+        print(padded(benchmark.name, to: 20) + benchmark.abstract)
+      }
+      return
+    }
+
+    let selected = names.isEmpty
+      ? benchmarks
+      : benchmarks.filter { names.contains($0.name) }
+
+    print(padded("benchmark", to: 20)
+      + padded("iterations", to: 12)
+      + padded("µs/iter", to: 14)
+      + padded("iter/s", to: 14)
+      + padded("heap growth (bytes)", to: 22)
+      + "block growth")
+
+    for benchmark in selected {
+      let result = cold
+        ? try benchmark.runCold(samples: samples)
+        : try benchmark.run(iterations: iterations)
+      print(padded(result.name, to: 20)
+        + padded("\(result.iterations)", to: 12)
+        + padded(format(result.nanosecondsPerIteration / 1000), to: 14)
+        + padded(format(result.iterationsPerSecond), to: 14)
+        + padded(result.heapGrowth.map { "\($0)" } ?? "unavailable", to: 22)
+        + (result.blockGrowth.map { "\($0)" } ?? "unavailable"))
+    }
+
+    if let peak = MemorySnapshot.current().peakResidentBytes {
+      print("\nPeak resident memory: \(peak / 1024) KiB")
+    }
+  }
+}
+
+ParseBenchmark.main()